@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Counts heap allocations and time for fetching the same blocks with
+// chain_get_block_by_height (each result destructed) and with
+// chain_get_block_by_height_arena (one reset per round).
+//
+// Usage: arena_alloc_bench <config-file> <height> [iterations]
+// Fetches the blocks [0, height] on every iteration.
+// Note: only the top-level result objects live in the arena, the libbitcoin
+//       objects still allocate their members through the global allocator.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <bitprim/nodecint/arena.h>
+#include <bitprim/nodecint/executor_c.h>
+#include <bitprim/nodecint/chain/block.h>
+#include <bitprim/nodecint/chain/chain.h>
+
+namespace {
+
+std::atomic<size_t> allocations(0);
+
+using bench_clock = std::chrono::steady_clock;
+
+double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+void report(char const* name, size_t blocks, size_t allocs, double secs) {
+    printf("%-6s %8zu blocks  %12zu allocations  %8.1f allocs/block  %10.3f s\n", name, blocks, allocs, double(allocs) / blocks, secs);
+}
+
+void run_heap(chain_t chain, uint64_t height, size_t iterations) {
+    auto const before = allocations.load();
+    auto start = bench_clock::now();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        for (uint64_t h = 0; h <= height; ++h) {
+            block_t block;
+            uint64_t out_height;
+            if (chain_get_block_by_height(chain, h, &block, &out_height) == 0) {
+                chain_block_destruct(block);
+            }
+        }
+    }
+
+    report("heap", iterations * (height + 1), allocations.load() - before, seconds_since(start));
+}
+
+void run_arena(chain_t chain, uint64_t height, size_t iterations) {
+    auto arena = nodecint_arena_construct(1024 * 1024);
+
+    auto const before = allocations.load();
+    auto start = bench_clock::now();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        for (uint64_t h = 0; h <= height; ++h) {
+            block_t block;
+            uint64_t out_height;
+            chain_get_block_by_height_arena(chain, arena, h, &block, &out_height);
+        }
+        nodecint_arena_reset(arena);
+    }
+
+    report("arena", iterations * (height + 1), allocations.load() - before, seconds_since(start));
+    printf("arena reserved %llu bytes\n", (unsigned long long)nodecint_arena_bytes_reserved(arena));
+    nodecint_arena_destruct(arena);
+}
+
+} /* end of anonymous namespace */
+
+void* operator new(size_t size) {
+    ++allocations;
+    if (auto* res = std::malloc(size == 0 ? 1 : size)) {
+        return res;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: %s <config-file> <height> [iterations]\n", argv[0]);
+        return -1;
+    }
+
+    uint64_t height = std::strtoull(argv[2], nullptr, 10);
+    size_t iterations = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10;
+
+    executor_t exec = executor_construct(argv[1], nullptr, stderr);
+
+    if (executor_run_wait(exec) != 0) {
+        printf("Error running the node\n");
+        executor_destruct(exec);
+        return -1;
+    }
+
+    chain_t chain = executor_get_chain(exec);
+
+    run_heap(chain, height, iterations);
+    run_arena(chain, height, iterations);
+
+    executor_stop(exec);
+    executor_destruct(exec);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the deep copy fetch (chain_get_block_by_height) against the shared
+// handle fetch (chain_get_block_by_height_shared) for the same block.
+//
+// Usage: block_handles_bench <config-file> <height> [iterations]
+// The node must have synchronized up to <height>.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include <bitprim/nodecint/executor_c.h>
+#include <bitprim/nodecint/chain/block.h>
+#include <bitprim/nodecint/chain/chain.h>
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+void report(char const* name, uint64_t iterations, uint64_t block_size, double secs) {
+    printf("%-8s %10llu fetches  %10.3f s  %12.1f fetches/s  %10.1f MB/s\n",
+           name,
+           static_cast<unsigned long long>(iterations),
+           secs,
+           iterations / secs,
+           (iterations * block_size) / secs / (1024.0 * 1024.0));
+}
+
+} /* end of anonymous namespace */
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: %s <config-file> <height> [iterations]\n", argv[0]);
+        return -1;
+    }
+
+    uint64_t height = std::strtoull(argv[2], nullptr, 10);
+    uint64_t iterations = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000;
+
+    executor_t exec = executor_construct(argv[1], nullptr, stderr);
+
+    if (executor_run_wait(exec) != 0) {
+        printf("Error running the node\n");
+        executor_destruct(exec);
+        return -1;
+    }
+
+    chain_t chain = executor_get_chain(exec);
+
+    block_t block;
+    uint64_t out_height;
+    if (chain_get_block_by_height(chain, height, &block, &out_height) != 0) {
+        printf("Block %llu not found\n", static_cast<unsigned long long>(height));
+        executor_stop(exec);
+        executor_destruct(exec);
+        return -1;
+    }
+
+    uint64_t block_size = chain_block_serialized_size(block, 0);
+    uint64_t tx_count = chain_block_transaction_count(block);
+    chain_block_destruct(block);
+
+    printf("block %llu: %llu bytes, %llu transactions\n",
+           static_cast<unsigned long long>(height),
+           static_cast<unsigned long long>(block_size),
+           static_cast<unsigned long long>(tx_count));
+
+    // The transaction count is read on every iteration so both modes touch the result.
+    uint64_t checksum = 0;
+
+    auto start = bench_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        chain_get_block_by_height(chain, height, &block, &out_height);
+        checksum += chain_block_transaction_count(block);
+        chain_block_destruct(block);
+    }
+    report("copy", iterations, block_size, seconds_since(start));
+
+    start = bench_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        block_ptr_t block_ptr;
+        chain_get_block_by_height_shared(chain, height, &block_ptr, &out_height);
+        checksum += chain_block_transaction_count(chain_block_ptr_get(block_ptr));
+        chain_block_ptr_release(block_ptr);
+    }
+    report("shared", iterations, block_size, seconds_since(start));
+
+    if (checksum != 2 * iterations * tx_count) {
+        printf("Unexpected transaction count\n");
+    }
+
+    executor_stop(exec);
+    executor_destruct(exec);
+    return 0;
+}
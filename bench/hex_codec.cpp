@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures the hex decode/encode throughput of each codec available on the running CPU.
+//
+// Usage: hex_codec_bench [bytes] [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <bitprim/nodecint/hex.hpp>
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+void report(char const* name, char const* operation, size_t bytes, double secs) {
+    printf("%-7s %-7s %10.1f MB/s\n", name, operation, bytes / secs / 1e6);
+}
+
+void run(char const* name, bitprim::hex::decode_function decode, bitprim::hex::encode_function encode,
+         std::vector<uint8_t> const& data, std::string const& hex, size_t iterations) {
+    if (decode == nullptr || encode == nullptr) {
+        printf("%-7s not supported\n", name);
+        return;
+    }
+
+    std::vector<uint8_t> decoded(data.size());
+    std::string encoded(hex.size(), '\0');
+
+    bool valid = true;
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        valid &= decode(hex.data(), data.size(), decoded.data());
+    }
+    report(name, "decode", data.size() * iterations, seconds_since(start));
+
+    if ( ! valid || decoded != data) {
+        printf("%-7s decode mismatch\n", name);
+    }
+
+    start = bench_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        encode(data.data(), data.size(), &encoded[0]);
+    }
+    report(name, "encode", data.size() * iterations, seconds_since(start));
+
+    if (encoded != hex) {
+        printf("%-7s encode mismatch\n", name);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t const bytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100 * 1024;
+    size_t const iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+
+    std::vector<uint8_t> data(bytes);
+    std::srand(42);
+    for (auto& x : data) {
+        x = static_cast<uint8_t>(std::rand());
+    }
+
+    std::string hex(2 * bytes, '\0');
+    bitprim::hex::encode_scalar(data.data(), data.size(), &hex[0]);
+
+    run("scalar", bitprim::hex::decode_scalar, bitprim::hex::encode_scalar, data, hex, iterations);
+    run("ssse3", bitprim::hex::decode_ssse3(), bitprim::hex::encode_ssse3(), data, hex, iterations);
+    run("avx2", bitprim::hex::decode_avx2(), bitprim::hex::encode_avx2(), data, hex, iterations);
+
+    return 0;
+}
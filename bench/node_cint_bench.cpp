@@ -0,0 +1,566 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Offline end to end benchmark of the C API.
+//
+// Initchains a temporary directory, writes a synthetic chain into it, runs a
+// node without network connections on top of it and reports throughput and
+// p50/p99 latency of the queries, validate_tx and the transaction subscription
+// at 1, 2, 4, ... <max-callers> concurrent callers.
+//
+// Usage: bitprim-node-cint-bench [blocks] [iterations] [max-callers] [directory]
+//
+// Note: block organization checks proof of work against the network limit, so
+//       synthetic blocks cannot go through chain_organize_block_sync. They are
+//       stored through the database before the node starts instead.
+// Note: the chain_get_* functions wait on their chain_fetch_* counterpart, so
+//       they measure both paths; fetch-only calls are awaited on a promise.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <bitprim/nodecint/executor_c.h>
+#include <bitprim/nodecint/chain/block.h>
+#include <bitprim/nodecint/chain/chain.h>
+#include <bitprim/nodecint/chain/compact_block.h>
+#include <bitprim/nodecint/chain/header.h>
+#include <bitprim/nodecint/chain/history_compact_list.h>
+#include <bitprim/nodecint/chain/merkle_block.h>
+#include <bitprim/nodecint/chain/output_point.h>
+#include <bitprim/nodecint/chain/payment_address.h>
+#include <bitprim/nodecint/chain/point.h>
+#include <bitprim/nodecint/chain/transaction.h>
+
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/config/settings.hpp>
+#include <bitcoin/bitcoin/formats/base_16.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/bitcoin/message/version.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+#include <bitcoin/database/data_base.hpp>
+#include <bitcoin/database/settings.hpp>
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+constexpr uint64_t coinbase_value = 5000000000;
+constexpr uint64_t spendable_value = 100000000;
+constexpr size_t coinbase_maturity = 100;
+
+double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+double micros_since(bench_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+}
+
+hash_t to_hash(libbitcoin::hash_digest const& hash) {
+    hash_t res;
+    std::copy(hash.begin(), hash.end(), res.hash);
+    return res;
+}
+
+// Synthetic chain
+// ----------------------------------------------------------------------------
+
+struct synthetic_chain {
+    std::vector<libbitcoin::hash_digest> block_hashes;          // by height
+    std::vector<libbitcoin::hash_digest> transaction_hashes;    // not coinbase
+    std::vector<libbitcoin::chain::output_point> spent_points;
+    std::vector<std::string> addresses;
+    std::vector<libbitcoin::data_chunk> spendable;              // valid txs spending anyone-can-spend outputs
+};
+
+libbitcoin::chain::script anyone_can_spend() {
+    using libbitcoin::machine::operation;
+    return libbitcoin::chain::script(operation::list{operation(libbitcoin::machine::opcode::push_positive_1)});
+}
+
+libbitcoin::chain::script pay_to(libbitcoin::short_hash const& hash) {
+    return libbitcoin::chain::script(libbitcoin::chain::script::to_pay_key_hash_pattern(hash));
+}
+
+libbitcoin::chain::script height_script(size_t height) {
+    using libbitcoin::machine::operation;
+    auto const data = libbitcoin::to_little_endian(static_cast<uint32_t>(height));
+    return libbitcoin::chain::script(operation::list{operation(libbitcoin::to_chunk(data))});
+}
+
+// Outputs 0..n-1 fund the transactions of the next block, output n can be spent by anyone.
+libbitcoin::chain::transaction make_coinbase(size_t height, std::vector<libbitcoin::short_hash> const& addresses, size_t n) {
+    libbitcoin::chain::input::list inputs{
+        libbitcoin::chain::input(libbitcoin::chain::output_point(libbitcoin::null_hash, libbitcoin::chain::point::null_index),
+                                 height_script(height), libbitcoin::max_input_sequence)};
+
+    libbitcoin::chain::output::list outputs;
+    for (size_t i = 0; i < n; ++i) {
+        outputs.emplace_back(coinbase_value / (n + 1), pay_to(addresses[(height + i) % addresses.size()]));
+    }
+    outputs.emplace_back(spendable_value, anyone_can_spend());
+
+    return libbitcoin::chain::transaction(1, 0, std::move(inputs), std::move(outputs));
+}
+
+libbitcoin::chain::transaction make_spend(libbitcoin::chain::output_point const& point, libbitcoin::short_hash const& first, libbitcoin::short_hash const& second) {
+    libbitcoin::chain::input::list inputs{libbitcoin::chain::input(point, height_script(0), libbitcoin::max_input_sequence)};
+
+    libbitcoin::chain::output::list outputs;
+    outputs.emplace_back(coinbase_value / 4, pay_to(first));
+    outputs.emplace_back(coinbase_value / 4, pay_to(second));
+
+    return libbitcoin::chain::transaction(1, 0, std::move(inputs), std::move(outputs));
+}
+
+bool populate(std::string const& directory, size_t blocks, size_t txs_per_block, size_t address_count, synthetic_chain& out) {
+    libbitcoin::database::settings settings(libbitcoin::config::settings::mainnet);
+    settings.directory = directory;
+    settings.flush_writes = false;
+
+    libbitcoin::database::data_base db(settings);
+    if ( ! db.open()) {
+        return false;
+    }
+
+    std::vector<libbitcoin::short_hash> addresses;
+    for (size_t i = 0; i < address_count; ++i) {
+        addresses.push_back(libbitcoin::bitcoin_short_hash(libbitcoin::to_chunk(libbitcoin::to_little_endian(static_cast<uint32_t>(i)))));
+        out.addresses.push_back(libbitcoin::wallet::payment_address(addresses.back(), libbitcoin::wallet::payment_address::mainnet_p2kh).encoded());
+    }
+
+    auto const genesis = libbitcoin::chain::block::genesis_mainnet();
+    out.block_hashes.push_back(genesis.hash());
+
+    auto previous = genesis.header();
+    std::vector<libbitcoin::hash_digest> coinbases{genesis.transactions().front().hash()};
+
+    for (size_t height = 1; height <= blocks; ++height) {
+        libbitcoin::chain::transaction::list txs;
+        txs.push_back(make_coinbase(height, addresses, txs_per_block));
+
+        // The genesis coinbase has a single output, the first block only has its coinbase.
+        if (height > 1) {
+            for (size_t i = 0; i < txs_per_block; ++i) {
+                libbitcoin::chain::output_point const point(coinbases[height - 1], static_cast<uint32_t>(i));
+                txs.push_back(make_spend(point, addresses[(height * txs_per_block + i) % address_count],
+                                                addresses[(height * txs_per_block + i + 1) % address_count]));
+                out.spent_points.push_back(point);
+                out.transaction_hashes.push_back(txs.back().hash());
+            }
+        }
+
+        coinbases.push_back(txs.front().hash());
+
+        libbitcoin::chain::header header(previous.version(), previous.hash(), libbitcoin::null_hash,
+                                         previous.timestamp() + 600, previous.bits(), static_cast<uint32_t>(height));
+        libbitcoin::chain::block block(header, std::move(txs));
+        block.header().set_merkle(block.generate_merkle_root());
+
+        auto const ec = db.push(block, height);
+        if (ec) {
+            db.close();
+            return false;
+        }
+
+        out.block_hashes.push_back(block.hash());
+        previous = block.header();
+    }
+
+    // Mature anyone-can-spend outputs, validated without signatures.
+    for (size_t height = 1; height + coinbase_maturity <= blocks; ++height) {
+        libbitcoin::chain::output_point const point(coinbases[height], static_cast<uint32_t>(txs_per_block));
+        libbitcoin::chain::input::list inputs{libbitcoin::chain::input(point, libbitcoin::chain::script(), libbitcoin::max_input_sequence)};
+        libbitcoin::chain::output::list outputs{libbitcoin::chain::output(spendable_value, anyone_can_spend())};
+        libbitcoin::chain::transaction const tx(1, 0, std::move(inputs), std::move(outputs));
+        out.spendable.push_back(tx.to_data());
+    }
+
+    return db.close();
+}
+
+bool write_config(std::string const& path, boost::filesystem::path const& directory) {
+    std::ofstream file(path);
+    file << "[log]\n"
+         << "debug_file = " << (directory / "debug.log").string() << "\n"
+         << "error_file = " << (directory / "error.log").string() << "\n"
+         << "archive_directory = " << (directory / "archive").string() << "\n"
+         << "[network]\n"
+         << "inbound_connections = 0\n"
+         << "outbound_connections = 0\n"
+         << "host_pool_capacity = 0\n"
+         << "hosts_file = " << (directory / "hosts.cache").string() << "\n"
+         << "[database]\n"
+         << "directory = " << (directory / "blockchain").string() << "\n"
+         << "flush_writes = false\n"
+         << "[node]\n"
+         << "byte_fee_satoshis = 0\n"
+         << "sigop_fee_satoshis = 0\n"
+         << "minimum_output_satoshis = 0\n";
+    return file.good();
+}
+
+// Measurement
+// ----------------------------------------------------------------------------
+
+void report(char const* name, size_t callers, std::vector<double>& latencies, size_t errors, double secs) {
+    if (latencies.empty()) {
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto const p50 = latencies[latencies.size() / 2];
+    auto const p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+
+    printf("%-34s %3zu callers %11.1f ops/s  p50 %10.1f us  p99 %10.1f us  errors %zu\n",
+           name, callers, latencies.size() / secs, p50, p99, errors);
+}
+
+// op(i) runs the i-th call and returns its error code.
+template <typename Operation>
+void measure(char const* name, size_t iterations, size_t max_callers, Operation op) {
+    for (size_t callers = 1; callers <= max_callers; callers *= 2) {
+        std::vector<std::vector<double>> latencies(callers);
+        std::atomic<size_t> next(0);
+        std::atomic<size_t> errors(0);
+        std::vector<std::thread> threads;
+
+        auto const start = bench_clock::now();
+        for (size_t t = 0; t < callers; ++t) {
+            threads.emplace_back([&, t]() {
+                size_t i;
+                while ((i = next++) < iterations) {
+                    auto const call_start = bench_clock::now();
+                    if (op(i) != 0) {
+                        ++errors;
+                    }
+                    latencies[t].push_back(micros_since(call_start));
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto const secs = seconds_since(start);
+
+        std::vector<double> all;
+        for (auto const& x : latencies) {
+            all.insert(all.end(), x.begin(), x.end());
+        }
+        report(name, callers, all, errors, secs);
+    }
+}
+
+void spend_handler(chain_t /*chain*/, void* ctx, int error, input_point_t input_point) {
+    chain_point_destruct(input_point);
+    static_cast<std::promise<int>*>(ctx)->set_value(error);
+}
+
+void validate_handler(chain_t /*chain*/, void* ctx, int error, char const* /*message*/) {
+    static_cast<std::promise<int>*>(ctx)->set_value(error);
+}
+
+int transaction_handler(executor_t /*exec*/, chain_t /*chain*/, void* ctx, int error, transaction_t tx) {
+    if (error != 0 || tx == nullptr) {
+        return 0;
+    }
+
+    chain_transaction_destruct(tx);
+    auto* received = static_cast<std::atomic<size_t>*>(ctx);
+    ++*received;
+    return 1;
+}
+
+void run_queries(executor_t exec, synthetic_chain const& data, size_t iterations, size_t max_callers) {
+    chain_t chain = executor_get_chain(exec);
+    auto const blocks = data.block_hashes.size();
+
+    measure("chain_get_last_height", iterations, max_callers, [&](size_t) {
+        uint64_t height;
+        return chain_get_last_height(chain, &height);
+    });
+
+    measure("chain_get_block_height", iterations, max_callers, [&](size_t i) {
+        uint64_t height;
+        return chain_get_block_height(chain, to_hash(data.block_hashes[i % blocks]), &height);
+    });
+
+    measure("chain_get_block_header_by_height", iterations, max_callers, [&](size_t i) {
+        header_t header;
+        uint64_t height;
+        auto res = chain_get_block_header_by_height(chain, i % blocks, &header, &height);
+        if (res == 0) {
+            chain_header_destruct(header);
+        }
+        return res;
+    });
+
+    measure("chain_get_block_header_by_hash", iterations, max_callers, [&](size_t i) {
+        header_t header;
+        uint64_t height;
+        auto res = chain_get_block_header_by_hash(chain, to_hash(data.block_hashes[i % blocks]), &header, &height);
+        if (res == 0) {
+            chain_header_destruct(header);
+        }
+        return res;
+    });
+
+    measure("chain_get_block_headers_range", iterations, max_callers, [&](size_t i) {
+        uint64_t const count = 100;
+        std::vector<uint8_t> headers(count * BITCOIN_HEADER_SIZE);
+        std::vector<hash_t> hashes(count);
+        uint64_t out_count;
+        return chain_get_block_headers_range(chain, i % blocks, count, headers.data(), hashes.data(), &out_count);
+    });
+
+    measure("chain_get_block_by_height", iterations, max_callers, [&](size_t i) {
+        block_t block;
+        uint64_t height;
+        auto res = chain_get_block_by_height(chain, i % blocks, &block, &height);
+        if (res == 0) {
+            chain_block_destruct(block);
+        }
+        return res;
+    });
+
+    measure("chain_get_block_by_hash", iterations, max_callers, [&](size_t i) {
+        block_t block;
+        uint64_t height;
+        auto res = chain_get_block_by_hash(chain, to_hash(data.block_hashes[i % blocks]), &block, &height);
+        if (res == 0) {
+            chain_block_destruct(block);
+        }
+        return res;
+    });
+
+    measure("chain_get_block_by_height_shared", iterations, max_callers, [&](size_t i) {
+        block_ptr_t block;
+        uint64_t height;
+        auto res = chain_get_block_by_height_shared(chain, i % blocks, &block, &height);
+        if (res == 0) {
+            chain_block_ptr_release(block);
+        }
+        return res;
+    });
+
+    measure("chain_get_block_raw_by_height", iterations, max_callers, [&](size_t i) {
+        std::vector<uint8_t> buffer(1024 * 1024);
+        uint64_t size;
+        uint64_t height;
+        return chain_get_block_raw_by_height(chain, i % blocks, buffer.data(), buffer.size(), &size, &height);
+    });
+
+    measure("chain_get_merkle_block_by_height", iterations, max_callers, [&](size_t i) {
+        merkle_block_t block;
+        uint64_t height;
+        auto res = chain_get_merkle_block_by_height(chain, i % blocks, &block, &height);
+        if (res == 0) {
+            chain_merkle_block_destruct(block);
+        }
+        return res;
+    });
+
+    measure("chain_get_compact_block_by_height", iterations, max_callers, [&](size_t i) {
+        compact_block_t block;
+        uint64_t height;
+        auto res = chain_get_compact_block_by_height(chain, i % blocks, &block, &height);
+        if (res == 0) {
+            compact_block_destruct(block);
+        }
+        return res;
+    });
+
+    if ( ! data.transaction_hashes.empty()) {
+        auto const txs = data.transaction_hashes.size();
+
+        measure("chain_get_transaction", iterations, max_callers, [&](size_t i) {
+            transaction_t tx;
+            uint64_t height;
+            uint64_t index;
+            auto res = chain_get_transaction(chain, to_hash(data.transaction_hashes[i % txs]), 1, &tx, &height, &index);
+            if (res == 0) {
+                chain_transaction_destruct(tx);
+            }
+            return res;
+        });
+
+        measure("chain_get_transaction_raw", iterations, max_callers, [&](size_t i) {
+            uint8_t buffer[1024];
+            uint64_t size;
+            uint64_t height;
+            uint64_t index;
+            return chain_get_transaction_raw(chain, to_hash(data.transaction_hashes[i % txs]), 1, buffer, sizeof(buffer), &size, &height, &index);
+        });
+
+        measure("chain_get_transaction_position", iterations, max_callers, [&](size_t i) {
+            uint64_t position;
+            uint64_t height;
+            return chain_get_transaction_position(chain, to_hash(data.transaction_hashes[i % txs]), 1, &position, &height);
+        });
+
+        measure("chain_fetch_spend", iterations, max_callers, [&](size_t i) {
+            auto const& point = data.spent_points[i % data.spent_points.size()];
+            auto op = output_point_construct_from_hash_index(to_hash(point.hash()), point.index());
+            std::promise<int> done;
+            chain_fetch_spend(chain, &done, op, spend_handler);
+            auto res = done.get_future().get();
+            output_point_destruct(op);
+            return res;
+        });
+    }
+
+    measure("chain_get_history", iterations, max_callers, [&](size_t i) {
+        auto address = chain_payment_address_construct_from_string(data.addresses[i % data.addresses.size()].c_str());
+        history_compact_list_t history;
+        auto res = chain_get_history(chain, address, 0, 0, &history);
+        if (res == 0) {
+            chain_history_compact_list_destruct(history);
+        }
+        chain_payment_address_destruct(address);
+        return res;
+    });
+}
+
+void run_validation(executor_t exec, synthetic_chain const& data, size_t iterations, size_t max_callers) {
+    if (data.spendable.empty()) {
+        printf("Not enough blocks to mature coinbase outputs, validation skipped\n");
+        return;
+    }
+
+    chain_t chain = executor_get_chain(exec);
+
+    // hex_to_tx marks the transactions as simulated, so validating them does not reach the pool.
+    std::vector<transaction_t> txs;
+    for (auto const& raw : data.spendable) {
+        txs.push_back(hex_to_tx(libbitcoin::encode_base16(raw).c_str()));
+    }
+
+    measure("chain_validate_tx", iterations, max_callers, [&](size_t i) {
+        std::promise<int> done;
+        chain_validate_tx(chain, &done, txs[i % txs.size()], validate_handler);
+        return done.get_future().get();
+    });
+
+    auto const start = bench_clock::now();
+    std::vector<int> errors(txs.size());
+    auto const invalid = chain_validate_tx_batch_sync(chain, txs.data(), txs.size(), errors.data());
+    auto const secs = seconds_since(start);
+    printf("%-34s %7zu txs %11.1f txs/s  invalid %llu\n", "chain_validate_tx_batch_sync",
+           txs.size(), txs.size() / secs, static_cast<unsigned long long>(invalid));
+
+    for (auto tx : txs) {
+        chain_transaction_destruct(tx);
+    }
+}
+
+// Each transaction is organized once, from a single caller, until its notification arrives.
+void run_subscription(executor_t exec, synthetic_chain const& data) {
+    chain_t chain = executor_get_chain(exec);
+    std::atomic<size_t> received(0);
+    chain_subscribe_transaction(exec, chain, &received, transaction_handler);
+
+    std::vector<double> latencies;
+    size_t errors = 0;
+    auto const start = bench_clock::now();
+
+    for (auto const& raw : data.spendable) {
+        auto tx = chain_transaction_factory_from_data(libbitcoin::message::version::level::canonical, raw.data(), raw.size());
+        auto const expected = received.load() + 1;
+
+        auto const call_start = bench_clock::now();
+        if (chain_organize_transaction_sync(chain, tx) != 0) {
+            ++errors;
+        } else {
+            while (received.load() < expected) {
+                std::this_thread::yield();
+            }
+        }
+        latencies.push_back(micros_since(call_start));
+        chain_transaction_destruct(tx);
+    }
+
+    report("subscribe_transaction (organize)", 1, latencies, errors, seconds_since(start));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t const blocks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 300;
+    size_t const iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    size_t const max_callers = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 8;
+    size_t const txs_per_block = 20;
+    size_t const address_count = 1000;
+
+    auto const directory = argc > 4
+        ? boost::filesystem::path(argv[4])
+        : boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("bitprim-bench-%%%%-%%%%-%%%%");
+
+    if (boost::filesystem::exists(directory) || ! boost::filesystem::create_directories(directory)) {
+        printf("Could not create a fresh directory %s\n", directory.string().c_str());
+        return -1;
+    }
+
+    auto const config = (directory / "bench.cfg").string();
+    if ( ! write_config(config, directory)) {
+        printf("Could not write %s\n", config.c_str());
+        return -1;
+    }
+
+    executor_t exec = executor_construct(config.c_str(), nullptr, stderr);
+    int res = -1;
+    synthetic_chain data;
+
+    printf("Populating %zu blocks, %zu transactions per block, in %s\n", blocks, txs_per_block, directory.string().c_str());
+    auto const start = bench_clock::now();
+
+    if (executor_initchain(exec) == 0) {
+        printf("Error initializing the chain\n");
+    } else if ( ! populate((directory / "blockchain").string(), blocks, txs_per_block, address_count, data)) {
+        printf("Error writing the synthetic chain\n");
+    } else if (executor_run_wait(exec) != 0) {
+        printf("Error running the node\n");
+    } else {
+        printf("Populated in %.3f s\n\n", seconds_since(start));
+        run_queries(exec, data, iterations, max_callers);
+        run_validation(exec, data, iterations, max_callers);
+        run_subscription(exec, data);
+        executor_stop(exec);
+        res = 0;
+    }
+
+    executor_destruct(exec);
+
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(directory, ec);
+    return res;
+}
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures the double SHA-256 throughput of each backend available on the running CPU,
+// for 64 bytes inputs (merkle nodes) and 80 bytes inputs (block headers).
+//
+// Usage: sha256_bench [inputs] [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <bitprim/nodecint/sha256.hpp>
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+void report(char const* name, char const* operation, size_t hashes, double secs) {
+    printf("%-7s %-9s %10.2f Mhash/s\n", name, operation, hashes / secs / 1e6);
+}
+
+void run64(char const* name, bitprim::sha256::hash64_function hash64,
+           std::vector<uint8_t> const& data, std::vector<uint8_t> const& expected, size_t iterations) {
+    if (hash64 == nullptr) {
+        printf("%-7s not supported\n", name);
+        return;
+    }
+
+    auto const count = data.size() / 64;
+    std::vector<uint8_t> out(count * 32);
+
+    auto const start = bench_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        hash64(data.data(), count, out.data());
+    }
+    report(name, "64 bytes", count * iterations, seconds_since(start));
+
+    if (out != expected) {
+        printf("%-7s 64 bytes mismatch\n", name);
+    }
+}
+
+void run80(char const* name, bitprim::sha256::hash_function hash,
+           std::vector<uint8_t> const& data, size_t iterations) {
+    if (hash == nullptr) {
+        printf("%-7s not supported\n", name);
+        return;
+    }
+
+    auto const count = data.size() / 80;
+    std::vector<uint8_t> out(count * 32);
+    std::vector<uint8_t> expected(count * 32);
+
+    auto const start = bench_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        for (size_t j = 0; j < count; ++j) {
+            hash(data.data() + 80 * j, 80, out.data() + 32 * j);
+        }
+    }
+    report(name, "80 bytes", count * iterations, seconds_since(start));
+
+    for (size_t j = 0; j < count; ++j) {
+        bitprim::sha256::double_hash_scalar(data.data() + 80 * j, 80, expected.data() + 32 * j);
+    }
+
+    if (out != expected) {
+        printf("%-7s 80 bytes mismatch\n", name);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t const inputs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096;
+    size_t const iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+
+    std::vector<uint8_t> data(inputs * 80);
+    std::srand(42);
+    for (auto& x : data) {
+        x = static_cast<uint8_t>(std::rand());
+    }
+
+    std::vector<uint8_t> const nodes(data.begin(), data.begin() + inputs * 64);
+    std::vector<uint8_t> expected(inputs * 32);
+    bitprim::sha256::double_hash64_scalar(nodes.data(), inputs, expected.data());
+
+    printf("selected backend: %s\n", bitprim::sha256::backend_name());
+
+    run64("scalar", bitprim::sha256::double_hash64_scalar, nodes, expected, iterations);
+    run64("shani", bitprim::sha256::double_hash64_shani(), nodes, expected, iterations);
+    run64("avx2", bitprim::sha256::double_hash64_avx2(), nodes, expected, iterations);
+
+    run80("scalar", bitprim::sha256::double_hash_scalar, data, iterations);
+    run80("shani", bitprim::sha256::double_hash_shani(), data, iterations);
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares chain_fetch_stealth (database scan) with stealth_index_get at several
+// filter lengths, for the same random prefixes.
+//
+// Usage: stealth_index_bench <config-file> <from-height> [queries] [threads]
+// Builds the index from from-height first and reports the build time.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <bitprim/nodecint/binary.h>
+#include <bitprim/nodecint/executor_c.h>
+#include <bitprim/nodecint/stealth_index.h>
+#include <bitprim/nodecint/chain/chain.h>
+#include <bitprim/nodecint/chain/stealth_compact_list.h>
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+void report(char const* name, size_t bits, size_t queries, size_t rows, double secs) {
+    printf("%-8s %2zu bits  %6zu queries  %10zu rows  %10.3f ms/query\n", name, bits, queries, rows, secs * 1000 / queries);
+}
+
+void on_stealth(chain_t /*chain*/, void* ctx, int /*error*/, stealth_compact_list_t stealth) {
+    *static_cast<size_t*>(ctx) += stealth_compact_list_count(stealth);
+    stealth_compact_list_destruct(stealth);
+}
+
+void run(chain_t chain, stealth_index_t index, uint64_t from_height, size_t bits, size_t queries) {
+    std::mt19937 random(static_cast<unsigned>(bits));
+    std::vector<binary_t> filters;
+
+    for (size_t i = 0; i < queries; ++i) {
+        uint8_t blocks[4];
+        for (auto& block : blocks) {
+            block = static_cast<uint8_t>(random());
+        }
+        filters.push_back(binary_construct_blocks(bits, blocks, (bits + 7) / 8));
+    }
+
+    size_t rows = 0;
+    auto start = bench_clock::now();
+    for (auto filter : filters) {
+        chain_fetch_stealth(chain, &rows, filter, from_height, on_stealth);
+    }
+    report("database", bits, queries, rows, seconds_since(start));
+
+    rows = 0;
+    start = bench_clock::now();
+    for (auto filter : filters) {
+        auto stealth = stealth_index_get(index, filter, from_height);
+        rows += stealth_compact_list_count(stealth);
+        stealth_compact_list_destruct(stealth);
+    }
+    report("index", bits, queries, rows, seconds_since(start));
+
+    for (auto filter : filters) {
+        binary_destruct(filter);
+    }
+}
+
+} /* end of anonymous namespace */
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: %s <config-file> <from-height> [queries] [threads]\n", argv[0]);
+        return -1;
+    }
+
+    uint64_t from_height = std::strtoull(argv[2], nullptr, 10);
+    size_t queries = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 20;
+    size_t threads = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 0;
+
+    executor_t exec = executor_construct(argv[1], nullptr, stderr);
+
+    if (executor_run_wait(exec) != 0) {
+        printf("Error running the node\n");
+        executor_destruct(exec);
+        return -1;
+    }
+
+    chain_t chain = executor_get_chain(exec);
+    stealth_index_t index = stealth_index_construct(chain, from_height);
+
+    auto start = bench_clock::now();
+    auto error = stealth_index_build(index, threads);
+    printf("build    error %d  %10zu rows  up to %llu  %10.3f s\n", error, (size_t)stealth_index_count(index), (unsigned long long)stealth_index_height(index), seconds_since(start));
+
+    for (size_t bits : {4, 8, 16, 24, 32}) {
+        run(chain, index, from_height, bits, queries);
+    }
+
+    stealth_index_destruct(index);
+    executor_stop(exec);
+    executor_destruct(exec);
+    return 0;
+}
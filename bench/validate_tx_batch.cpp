@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares looping over chain_validate_tx (waiting for each result) against
+// a single chain_validate_tx_batch_sync call for the same transactions.
+//
+// Usage: validate_tx_batch_bench <config-file> <hex-transactions-file> [loop|batch|both]
+// The file holds one hex encoded transaction per line.
+// Note: valid transactions are accepted into the pool by the first pass, so
+//       run each mode on a fresh node when comparing sets of valid transactions.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <bitprim/nodecint/executor_c.h>
+#include <bitprim/nodecint/chain/chain.h>
+#include <bitprim/nodecint/chain/transaction.h>
+
+#include <bitcoin/bitcoin/formats/base_16.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+void report(char const* name, size_t count, size_t invalid, double secs) {
+    printf("%-6s %8zu txs  %8zu invalid  %10.3f s  %12.1f txs/s\n", name, count, invalid, secs, count / secs);
+}
+
+std::vector<transaction_t> read_transactions(char const* path) {
+    std::vector<transaction_t> txs;
+    std::ifstream file(path);
+    std::string line;
+
+    while (std::getline(file, line)) {
+        libbitcoin::data_chunk data;
+        if (line.empty() || ! libbitcoin::decode_base16(data, line)) {
+            continue;
+        }
+
+        auto tx = libbitcoin::message::transaction::factory_from_data(libbitcoin::message::version::level::canonical, data);
+        if (tx.is_valid()) {
+            txs.push_back(new libbitcoin::message::transaction(std::move(tx)));
+        }
+    }
+
+    return txs;
+}
+
+void validate_handler(chain_t /*chain*/, void* ctx, int error, char const* /*message*/) {
+    static_cast<std::promise<int>*>(ctx)->set_value(error);
+}
+
+void run_loop(chain_t chain, std::vector<transaction_t> const& txs) {
+    size_t invalid = 0;
+
+    auto start = bench_clock::now();
+    for (auto tx : txs) {
+        std::promise<int> result;
+        chain_validate_tx(chain, &result, tx, validate_handler);
+        if (result.get_future().get() != 0) {
+            ++invalid;
+        }
+    }
+    report("loop", txs.size(), invalid, seconds_since(start));
+}
+
+void run_batch(chain_t chain, std::vector<transaction_t> const& txs) {
+    std::vector<int> errors(txs.size());
+
+    auto start = bench_clock::now();
+    auto invalid = chain_validate_tx_batch_sync(chain, txs.data(), txs.size(), errors.data());
+    report("batch", txs.size(), invalid, seconds_since(start));
+}
+
+} /* end of anonymous namespace */
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: %s <config-file> <hex-transactions-file> [loop|batch|both]\n", argv[0]);
+        return -1;
+    }
+
+    char const* mode = argc > 3 ? argv[3] : "both";
+
+    auto txs = read_transactions(argv[2]);
+    if (txs.empty()) {
+        printf("No transactions found in %s\n", argv[2]);
+        return -1;
+    }
+
+    executor_t exec = executor_construct(argv[1], nullptr, stderr);
+
+    if (executor_run_wait(exec) != 0) {
+        printf("Error running the node\n");
+        executor_destruct(exec);
+        return -1;
+    }
+
+    chain_t chain = executor_get_chain(exec);
+
+    if (std::strcmp(mode, "batch") != 0) {
+        run_loop(chain, txs);
+    }
+
+    if (std::strcmp(mode, "loop") != 0) {
+        run_batch(chain, txs);
+    }
+
+    for (auto tx : txs) {
+        chain_transaction_destruct(tx);
+    }
+
+    executor_stop(exec);
+    executor_destruct(exec);
+    return 0;
+}
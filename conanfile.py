@@ -55,7 +55,7 @@ class BitprimNodeCIntConan(ConanFile):
     # "use_cpp11_abi=True"
 
     generators = "cmake"
-    exports_sources = "src/*", "CMakeLists.txt", "cmake/*", "bitprim-node-cintConfig.cmake.in", "include/*", "test/*", "console/*"
+    exports_sources = "src/*", "CMakeLists.txt", "cmake/*", "bitprim-node-cintConfig.cmake.in", "include/*", "test/*", "console/*", "bench/*"
     package_files = "build/lbitprim-node-cint.so"
     build_policy = "missing"
 
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_API_STATS_HPP_
+#define BITPRIM_NODECINT_API_STATS_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <bitprim/nodecint/primitives.h>
+
+namespace bitprim { namespace nodecint {
+
+// Log-linear histogram (16 sub-buckets per power of two), lock-free to record.
+class api_histogram
+{
+public:
+    api_histogram();
+
+    void record(uint64_t value);
+
+    uint64_t count() const;
+    uint64_t sum() const;
+    uint64_t max() const;
+
+    // Upper bound of the bucket holding the q quantile (0 <= q <= 1).
+    uint64_t quantile(double q) const;
+
+private:
+    static constexpr size_t sub_bits = 4;
+    static constexpr size_t sub_count = size_t(1) << sub_bits;
+    static constexpr size_t max_exponent = 44;      // about 4.8 hours in nanoseconds, larger values are clamped
+    static constexpr size_t bucket_count = (max_exponent - sub_bits + 2) * sub_count;
+
+    static size_t bucket(uint64_t value);
+    static uint64_t bucket_upper_bound(size_t index);
+
+    std::array<std::atomic<uint64_t>, bucket_count> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+class api_entry
+{
+public:
+    explicit api_entry(std::string name);
+
+    api_entry(api_entry const&) = delete;
+    void operator=(api_entry const&) = delete;
+
+    std::string const& name() const;
+
+    void record_latency(uint64_t nanoseconds);
+    void record_blocked(uint64_t nanoseconds);
+
+    api_stats_t stats() const;
+
+    api_histogram const& latency() const;
+    api_histogram const& blocked() const;
+
+private:
+    std::string const name_;
+    api_histogram latency_;
+    api_histogram blocked_;
+};
+
+// The entry of an API function, registered on first use. The reference stays valid until the process ends.
+api_entry& api_stats_entry(char const* name);
+
+// Every registered entry, in registration order.
+std::vector<api_entry const*> api_stats_entries();
+
+// Prometheus text exposition format.
+std::string api_stats_prometheus();
+
+using api_clock = std::chrono::steady_clock;
+
+inline
+uint64_t nanoseconds_since(api_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(api_clock::now() - start).count();
+}
+
+// Records the time from its construction to the first call as the latency of the entry.
+template <typename Handler>
+class timed_handler
+{
+public:
+    timed_handler(api_entry& entry, Handler handler)
+        : entry_(&entry), start_(api_clock::now()), handler_(std::move(handler))
+    {}
+
+    template <typename... Args>
+    auto operator()(Args&&... args) -> decltype(std::declval<Handler&>()(std::forward<Args>(args)...)) {
+        entry_->record_latency(nanoseconds_since(start_));
+        return handler_(std::forward<Args>(args)...);
+    }
+
+private:
+    api_entry* entry_;
+    api_clock::time_point start_;
+    Handler handler_;
+};
+
+template <typename Handler>
+timed_handler<Handler> timed(api_entry& entry, Handler handler) {
+    return timed_handler<Handler>(entry, std::move(handler));
+}
+
+// latch.count_down_and_wait(), recording the time blocked.
+template <typename Latch>
+void timed_wait(Latch& latch, api_entry& entry) {
+    auto const start = api_clock::now();
+    latch.count_down_and_wait();
+    entry.record_blocked(nanoseconds_since(start));
+}
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_API_STATS_HPP_ */
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_ARENA_H_
+#define BITPRIM_NODECINT_ARENA_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Note: Bump arena owning the results of the *_arena fetch functions. Every object allocated in the arena
+//      is released at once by nodecint_arena_reset or nodecint_arena_destruct, never with its *_destruct function.
+//      The arena can be shared by concurrent requests, it must outlive every request using it.
+BITPRIM_EXPORT
+nodecint_arena_t nodecint_arena_construct(uint64_t /*size_t*/ block_size);
+
+BITPRIM_EXPORT
+void nodecint_arena_destruct(nodecint_arena_t arena);
+
+//Note: Releases every object, the memory is kept for reuse.
+BITPRIM_EXPORT
+void nodecint_arena_reset(nodecint_arena_t arena);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ nodecint_arena_object_count(nodecint_arena_t arena);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ nodecint_arena_bytes_used(nodecint_arena_t arena);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ nodecint_arena_bytes_reserved(nodecint_arena_t arena);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_ARENA_H_ */
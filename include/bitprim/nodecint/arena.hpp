@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_ARENA_HPP_
+#define BITPRIM_NODECINT_ARENA_HPP_
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bitprim { namespace nodecint {
+
+class arena
+{
+public:
+    explicit arena(size_t block_size);
+    ~arena();
+
+    arena(arena const&) = delete;
+    void operator=(arena const&) = delete;
+
+    // The object is destructed by reset() or by the arena destructor.
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        ++objects_;
+
+        if ( ! std::is_trivially_destructible<T>::value) {
+            auto* node = new (allocate(sizeof(destructor), alignof(destructor))) destructor{&destroy<T>, object, destructors_};
+            destructors_ = node;
+        }
+
+        return object;
+    }
+
+    // Null-terminated copy, valid until reset().
+    char const* copy(std::string const& str);
+
+    void reset();
+
+    size_t object_count() const;
+    size_t bytes_used() const;
+    size_t bytes_reserved() const;
+
+private:
+    struct destructor {
+        void (*destroy)(void*);
+        void* object;
+        destructor* next;
+    };
+
+    struct block {
+        char* data;
+        size_t size;
+    };
+
+    template <typename T>
+    static void destroy(void* object) {
+        static_cast<T*>(object)->~T();
+    }
+
+    void* allocate(size_t size, size_t alignment);
+    void release_objects();
+
+    mutable std::mutex mutex_;
+    size_t const block_size_;
+    std::vector<block> blocks_;
+    size_t current_ = 0;        // block being filled
+    size_t offset_ = 0;         // in the current block
+    size_t used_ = 0;           // bytes in the blocks before the current one
+    size_t objects_ = 0;
+    destructor* destructors_ = nullptr;
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_ARENA_HPP_ */
@@ -46,6 +46,9 @@ uint8_t const* binary_blocks(binary_t binary, uint64_t* /*size_t*/ out_n);
 BITPRIM_EXPORT
 char* binary_encoded(binary_t binary);
 
+BITPRIM_EXPORT
+void binary_destruct(binary_t binary);
+
 //BITPRIM_EXPORT
 //void word_list_add_word(word_list_t word_list, char const* word);
 
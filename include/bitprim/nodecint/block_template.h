@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_BLOCK_TEMPLATE_H_
+#define BITPRIM_NODECINT_BLOCK_TEMPLATE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Note: Keeps a block template on top of the current tip, fed by the transactions accepted after it is constructed.
+//      Each new transaction is appended to the selection (with the merkle branch updated in place) when it fits and
+//      its pool parents are already selected. The selection is rebuilt by fee rate on every new tip.
+//      A reorganization puts the transactions of the replaced blocks back in the pool. Over max_pool_count pool
+//      transactions (0 means no cap) the lowest fee rates are evicted.
+//      max_block_size includes the space reserved for the coinbase. The chain must be running.
+BITPRIM_EXPORT
+block_template_t block_template_construct(chain_t chain, uint64_t /*size_t*/ max_block_size, uint64_t /*size_t*/ max_pool_count);
+
+BITPRIM_EXPORT
+void block_template_destruct(block_template_t tmpl);
+
+//Note: the snapshot shares the transactions with the template (no deep copy).
+//      It is the user's responsibility to release the snapshot returned.
+BITPRIM_EXPORT
+block_template_snapshot_t block_template_snapshot(block_template_t tmpl);
+
+BITPRIM_EXPORT
+void block_template_stats(block_template_t tmpl, block_template_stats_t* out_stats);
+
+BITPRIM_EXPORT
+void chain_block_template_snapshot_destruct(block_template_snapshot_t snapshot);
+
+//Note: increases on every change of the selection, equal revisions hold the same transactions.
+BITPRIM_EXPORT
+uint64_t chain_block_template_snapshot_revision(block_template_snapshot_t snapshot);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_block_template_snapshot_height(block_template_snapshot_t snapshot);
+
+BITPRIM_EXPORT
+hash_t chain_block_template_snapshot_previous_hash(block_template_snapshot_t snapshot);
+
+//Note: sum of the fees of the selected transactions, the coinbase is not included.
+BITPRIM_EXPORT
+uint64_t chain_block_template_snapshot_fees(block_template_snapshot_t snapshot);
+
+//Note: size of the selected transactions, the header and the coinbase are not included.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_block_template_snapshot_serialized_size(block_template_snapshot_t snapshot);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_block_template_snapshot_transaction_count(block_template_snapshot_t snapshot);
+
+//Note: the transactions follow the coinbase, n = 0 is the first one after it.
+BITPRIM_EXPORT
+hash_t chain_block_template_snapshot_transaction_hash(block_template_snapshot_t snapshot, uint64_t /*size_t*/ n);
+
+//Note: It is the user's responsibility to release the handle
+BITPRIM_EXPORT
+transaction_ptr_t chain_block_template_snapshot_transaction(block_template_snapshot_t snapshot, uint64_t /*size_t*/ n);
+
+//Note: the merkle branch of the coinbase, from the leaves up. Hashing the coinbase hash with each of them
+//      (the coinbase hash on the left) gives the merkle root.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_block_template_snapshot_merkle_branch_count(block_template_snapshot_t snapshot);
+
+BITPRIM_EXPORT
+hash_t chain_block_template_snapshot_merkle_branch(block_template_snapshot_t snapshot, uint64_t /*size_t*/ n);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_BLOCK_TEMPLATE_H_ */
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_BLOCK_TEMPLATE_HPP_
+#define BITPRIM_NODECINT_BLOCK_TEMPLATE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <bitprim/nodecint/primitives.h>
+
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/blockchain/interface/safe_chain.hpp>
+
+namespace bitprim { namespace nodecint {
+
+struct block_template_snapshot {
+    uint64_t revision;
+    size_t height;
+    libbitcoin::hash_digest previous_hash;
+    uint64_t fees;
+    size_t serialized_size;
+    std::vector<libbitcoin::transaction_const_ptr> transactions;
+    std::vector<libbitcoin::hash_digest> hashes;
+    libbitcoin::hash_list merkle_branch;
+};
+
+class block_template
+{
+public:
+    using snapshot_ptr = std::shared_ptr<block_template_snapshot const>;
+
+    // A max_pool_count of 0 means no cap on the transactions kept for later templates.
+    block_template(libbitcoin::blockchain::safe_chain& chain, size_t max_block_size, size_t max_pool_count);
+    ~block_template();
+
+    block_template(block_template const&) = delete;
+    void operator=(block_template const&) = delete;
+
+    snapshot_ptr snapshot() const;
+    block_template_stats_t stats() const;
+
+private:
+    class store;
+
+    // Shared with the chain subscriptions, which can outlive the template.
+    std::shared_ptr<store> store_;
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_BLOCK_TEMPLATE_HPP_ */
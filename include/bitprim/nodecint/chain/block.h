@@ -44,6 +44,13 @@ block_t chain_block_construct(header_t header, transaction_list_t transactions);
 BITPRIM_EXPORT
 void chain_block_destruct(block_t block);
 
+//Note: the returned block is read-only, it is valid until the handle is released.
+BITPRIM_EXPORT
+block_t chain_block_ptr_get(block_ptr_t block);
+
+BITPRIM_EXPORT
+void chain_block_ptr_release(block_ptr_t block);
+
 BITPRIM_EXPORT
 int chain_block_is_valid(block_t block);
 
@@ -121,6 +128,21 @@ int /*bool*/ chain_block_is_internal_double_spend(block_t block);
 BITPRIM_EXPORT
 int /*bool*/ chain_block_is_valid_merkle_root(block_t block);
 
+//Note: only fills the counts of out_columns, use them to allocate the columns.
+BITPRIM_EXPORT
+void chain_block_columnar_sizes(block_t block, block_columnar_t* out_columns);
+
+//Note: fills the (non NULL) columns in one pass. Returns 0 on success, or 1 if the counts of columns
+//      are smaller than the ones of the block (nothing is written in that case).
+BITPRIM_EXPORT
+int chain_block_to_columnar(block_t block, block_columnar_t* columns);
+
+//Note: classifies every output script of the block in one pass, out gets one entry per output (in block order).
+//      capacity must be at least the output count (see chain_block_columnar_sizes).
+//      Returns 0 on success, or 1 if capacity is too small (nothing is written in that case).
+BITPRIM_EXPORT
+int chain_block_extract_output_destinations(block_t block, output_destination_t* out, uint64_t /*size_t*/ capacity);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
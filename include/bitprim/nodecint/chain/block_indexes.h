@@ -34,6 +34,9 @@ extern "C" {
 BITPRIM_EXPORT
 block_indexes_t chain_block_indexes_construct_default(void);
 
+BITPRIM_EXPORT
+block_indexes_t chain_block_indexes_construct_from_buffer(uint64_t const* buffer, uint64_t /*size_t*/ count);
+
 BITPRIM_EXPORT
 void chain_block_indexes_push_back(block_indexes_t list, uint64_t /*size_t*/ index);
 
@@ -46,6 +49,10 @@ uint64_t /*size_t*/ chain_block_indexes_count(block_indexes_t list);
 BITPRIM_EXPORT
 uint64_t /*size_t*/ chain_block_indexes_nth(block_indexes_t list, uint64_t /*size_t*/ n);
 
+//Note: copies up to capacity indexes into buffer, returns how many were copied.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_block_indexes_copy_to(block_indexes_t list, uint64_t* buffer, uint64_t /*size_t*/ capacity);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -46,6 +46,22 @@ uint64_t /*size_t*/ chain_block_list_count(block_list_t list);
 BITPRIM_EXPORT
 block_t chain_block_list_nth(block_list_t list, uint64_t /*size_t*/ n);
 
+//Note: 0 for a null list.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_block_ptr_list_count(block_ptr_list_t list);
+
+//Note: the returned block is read-only, it is valid until the list is released.
+BITPRIM_EXPORT
+block_t chain_block_ptr_list_nth(block_ptr_list_t list, uint64_t /*size_t*/ n);
+
+//Note: keeps the block alive after the list is released.
+BITPRIM_EXPORT
+block_ptr_t chain_block_ptr_list_nth_shared(block_ptr_list_t list, uint64_t /*size_t*/ n);
+
+//Note: a null list is accepted.
+BITPRIM_EXPORT
+void chain_block_ptr_list_release(block_ptr_list_t list);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -57,6 +57,29 @@ void chain_fetch_block_header_by_hash(chain_t chain, void* ctx, hash_t hash, blo
 BITPRIM_EXPORT
 int chain_get_block_header_by_hash(chain_t chain, hash_t hash, header_t* out_header, uint64_t /*size_t*/* out_height);
 
+//Note: headers are written serialized (BITCOIN_HEADER_SIZE bytes each) into out_headers, which must hold count headers.
+//      out_hashes is optional (may be NULL), if set it must hold count hashes.
+//      The result is 0 if all the headers were found, otherwise it is the error of the first missing height
+//      and out_count is the number of contiguous headers written.
+BITPRIM_EXPORT
+void chain_fetch_block_headers_range(chain_t chain, void* ctx, uint64_t /*size_t*/ from_height, uint64_t /*size_t*/ count, uint8_t* out_headers, hash_t* out_hashes, block_headers_range_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_headers_range(chain_t chain, uint64_t /*size_t*/ from_height, uint64_t /*size_t*/ count, uint8_t* out_headers, hash_t* out_hashes, uint64_t /*size_t*/* out_count);
+
+//Note: *_shared variants do not copy the object, the returned handle must be released with chain_header_ptr_release
+BITPRIM_EXPORT
+void chain_fetch_block_header_by_height_shared(chain_t chain, void* ctx, uint64_t /*size_t*/ height, block_header_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_header_by_height_shared(chain_t chain, uint64_t /*size_t*/ height, header_ptr_t* out_header, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_block_header_by_hash_shared(chain_t chain, void* ctx, hash_t hash, block_header_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_header_by_hash_shared(chain_t chain, hash_t hash, header_ptr_t* out_header, uint64_t /*size_t*/* out_height);
+
 
 // Block ---------------------------------------------------------------------
 BITPRIM_EXPORT
@@ -71,6 +94,19 @@ void chain_fetch_block_by_hash(chain_t chain, void* ctx, hash_t hash, block_fetc
 BITPRIM_EXPORT
 int chain_get_block_by_hash(chain_t chain, hash_t hash, block_t* out_block, uint64_t /*size_t*/* out_height);
 
+//Note: *_shared variants do not copy the block, the returned handle must be released with chain_block_ptr_release
+BITPRIM_EXPORT
+void chain_fetch_block_by_height_shared(chain_t chain, void* ctx, uint64_t /*size_t*/ height, block_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_by_height_shared(chain_t chain, uint64_t /*size_t*/ height, block_ptr_t* out_block, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_block_by_hash_shared(chain_t chain, void* ctx, hash_t hash, block_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_by_hash_shared(chain_t chain, hash_t hash, block_ptr_t* out_block, uint64_t /*size_t*/* out_height);
+
 
 // Merkle Block ---------------------------------------------------------------------
 BITPRIM_EXPORT
@@ -85,6 +121,35 @@ void chain_fetch_merkle_block_by_hash(chain_t chain, void* ctx, hash_t hash, mer
 BITPRIM_EXPORT
 int chain_get_merkle_block_by_hash(chain_t chain, hash_t hash, merkle_block_t* out_block, uint64_t /*size_t*/* out_height);
 
+//Note: *_raw variants write the canonical serialization of the block into buffer, no block copy is made.
+//      size is the serialized size of the block, if it is greater than buffer_size nothing is written
+//      and the error is operation_failed, so the call can be retried with a large enough buffer.
+BITPRIM_EXPORT
+void chain_fetch_block_raw_by_height(chain_t chain, void* ctx, uint64_t /*size_t*/ height, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, block_raw_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_raw_by_height(chain_t chain, uint64_t /*size_t*/ height, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, uint64_t /*size_t*/* out_size, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_block_raw_by_hash(chain_t chain, void* ctx, hash_t hash, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, block_raw_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_raw_by_hash(chain_t chain, hash_t hash, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, uint64_t /*size_t*/* out_size, uint64_t /*size_t*/* out_height);
+
+
+//Note: *_shared variants do not copy the block, the returned handle must be released with chain_merkle_block_ptr_release
+BITPRIM_EXPORT
+void chain_fetch_merkle_block_by_height_shared(chain_t chain, void* ctx, uint64_t /*size_t*/ height, merkle_block_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_merkle_block_by_height_shared(chain_t chain, uint64_t /*size_t*/ height, merkle_block_ptr_t* out_block, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_merkle_block_by_hash_shared(chain_t chain, void* ctx, hash_t hash, merkle_block_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_merkle_block_by_hash_shared(chain_t chain, hash_t hash, merkle_block_ptr_t* out_block, uint64_t /*size_t*/* out_height);
+
 
 // Compact Block ---------------------------------------------------------------------
 BITPRIM_EXPORT
@@ -99,6 +164,19 @@ void chain_fetch_compact_block_by_hash(chain_t chain, void* ctx, hash_t hash, co
 BITPRIM_EXPORT
 int chain_get_compact_block_by_hash(chain_t chain, hash_t hash, compact_block_t* out_block, uint64_t /*size_t*/* out_height);
 
+//Note: *_shared variants do not copy the block, the returned handle must be released with compact_block_ptr_release
+BITPRIM_EXPORT
+void chain_fetch_compact_block_by_height_shared(chain_t chain, void* ctx, uint64_t /*size_t*/ height, compact_block_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_compact_block_by_height_shared(chain_t chain, uint64_t /*size_t*/ height, compact_block_ptr_t* out_block, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_compact_block_by_hash_shared(chain_t chain, void* ctx, hash_t hash, compact_block_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_compact_block_by_hash_shared(chain_t chain, hash_t hash, compact_block_ptr_t* out_block, uint64_t /*size_t*/* out_height);
+
 // Transaction ---------------------------------------------------------------------
 BITPRIM_EXPORT
 void chain_fetch_transaction(chain_t chain, void* ctx, hash_t hash, int require_confirmed, transaction_fetch_handler_t handler);
@@ -106,12 +184,34 @@ void chain_fetch_transaction(chain_t chain, void* ctx, hash_t hash, int require_
 BITPRIM_EXPORT
 int chain_get_transaction(chain_t chain, hash_t hash, int require_confirmed, transaction_t* out_transaction, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index);
 
+//Note: see the *_raw block functions
+BITPRIM_EXPORT
+void chain_fetch_transaction_raw(chain_t chain, void* ctx, hash_t hash, int require_confirmed, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, transaction_raw_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_transaction_raw(chain_t chain, hash_t hash, int require_confirmed, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, uint64_t /*size_t*/* out_size, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index);
+
+//Note: *_shared variants do not copy the transaction, the returned handle must be released with chain_transaction_ptr_release
+BITPRIM_EXPORT
+void chain_fetch_transaction_shared(chain_t chain, void* ctx, hash_t hash, int require_confirmed, transaction_ptr_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_transaction_shared(chain_t chain, hash_t hash, int require_confirmed, transaction_ptr_t* out_transaction, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index);
+
 BITPRIM_EXPORT
 void chain_fetch_transaction_position(chain_t chain, void* ctx, hash_t hash, int require_confirmed, transaction_index_fetch_handler_t handler);
 
 BITPRIM_EXPORT
 int chain_get_transaction_position(chain_t chain, hash_t hash, int require_confirmed, uint64_t /*size_t*/* out_position, uint64_t /*size_t*/* out_height);
 
+//Note: the merkle branch of a confirmed transaction. The merkle trees of the last blocks asked for are cached,
+//      so the proofs of other transactions of the same blocks only cost the position and header lookups.
+BITPRIM_EXPORT
+void chain_fetch_merkle_proof(chain_t chain, void* ctx, hash_t hash, merkle_proof_t* out_proof, result_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_merkle_proof(chain_t chain, hash_t hash, merkle_proof_t* out_proof);
+
 
 // Output  ---------------------------------------------------------------------
 //Note: Removed on 3.3.0
@@ -132,8 +232,48 @@ void chain_fetch_history(chain_t chain, void* ctx, payment_address_t address, ui
 BITPRIM_EXPORT
 int chain_get_history(chain_t chain, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_compact_list_t* out_history);
 
+//Note: the cursor takes the history from the block chain, pages are moved out with chain_history_cursor_next and
+//      released from the cursor. The block chain reads the whole history at once, so the memory is not bounded
+//      by the page size: the cursor holds the entries not paged out yet.
+BITPRIM_EXPORT
+void chain_fetch_history_cursor(chain_t chain, void* ctx, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_cursor_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_history_cursor(chain_t chain, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_cursor_t* out_cursor);
+
+//Note: calls handler with consecutive chunks of up to chunk_size entries until the last one (last != 0) or until it returns 0.
+//      The chunk is owned by the library and only valid during the call, do not destruct it.
+BITPRIM_EXPORT
+void chain_fetch_history_chunked(chain_t chain, void* ctx, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, uint64_t /*size_t*/ chunk_size, history_chunk_handler_t handler);
+
+//Note: looks up the addresses in parallel on the executor worker threads (a fixed pool, one thread per core).
+//      The merged history is grouped by address index, or ordered
+//      by height (keeping the address order for equal heights) if sort_by_height is not 0.
+//      The error is the first one of the lookups, chain_history_multi_error gives the error of each address.
+BITPRIM_EXPORT
+void chain_fetch_history_multi(chain_t chain, void* ctx, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, int sort_by_height, history_multi_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_history_multi(chain_t chain, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, int sort_by_height, history_multi_t* out_history);
+
+//Note: the outputs of the address history not spent by it, computed from the whole history.
+//      history_cache_fetch_unspent_outputs memoizes them until a block or transaction touches the address.
+BITPRIM_EXPORT
+void chain_fetch_unspent_outputs(chain_t chain, void* ctx, payment_address_t address, unspent_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_unspent_outputs(chain_t chain, payment_address_t address, unspent_list_t* out_unspent);
+
+//Note: out_balances (count elements) receives the balance of each address, the addresses are looked up in parallel.
+BITPRIM_EXPORT
+void chain_fetch_balances(chain_t chain, void* ctx, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t* out_balances, result_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_balances(chain_t chain, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t* out_balances);
+
 
 // Stealth ---------------------------------------------------------------------
+//Note: scans the stealth rows of the database on the calling thread. For repeated queries see stealth_index.h.
 BITPRIM_EXPORT
 void chain_fetch_stealth(chain_t chain, void* ctx, binary_t filter, uint64_t from_height, stealth_fetch_handler_t handler);
 
@@ -142,23 +282,93 @@ void chain_fetch_stealth(chain_t chain, void* ctx, binary_t filter, uint64_t fro
 
 
 
+// Completion Queue ---------------------------------------------------------------------
+//Note: chain_submit_* functions push a completion_t tagged with user_id into the queue instead of calling a handler.
+//      They return before the lookup runs: it is posted to the executor workers (or run on the calling thread when
+//      the chain has no executor), so one thread can keep many lookups in flight. The arguments are copied.
+//      The result objects are owned by the user, the same as in the chain_fetch_* functions.
+
+//Note: completion_t::height is the last height
+BITPRIM_EXPORT
+void chain_submit_last_height(chain_t chain, completion_queue_t queue, uint64_t user_id);
+
+//Note: completion_t::height is the block height
+BITPRIM_EXPORT
+void chain_submit_block_height(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash);
+
+//Note: completion_t::result is a header_ptr_t, completion_t::height is the block height
+BITPRIM_EXPORT
+void chain_submit_block_header_by_height(chain_t chain, completion_queue_t queue, uint64_t user_id, uint64_t /*size_t*/ height);
+
+BITPRIM_EXPORT
+void chain_submit_block_header_by_hash(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash);
+
+//Note: completion_t::result is a block_ptr_t, completion_t::height is the block height
+BITPRIM_EXPORT
+void chain_submit_block_by_height(chain_t chain, completion_queue_t queue, uint64_t user_id, uint64_t /*size_t*/ height);
+
+BITPRIM_EXPORT
+void chain_submit_block_by_hash(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash);
+
+//Note: completion_t::result is a transaction_ptr_t, completion_t::height is the block height and completion_t::index the position in the block
+BITPRIM_EXPORT
+void chain_submit_transaction(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash, int require_confirmed);
+
+//Note: completion_t::height is the block height and completion_t::index the position in the block
+BITPRIM_EXPORT
+void chain_submit_transaction_position(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash, int require_confirmed);
+
+//Note: completion_t::result is a history_compact_list_t
+BITPRIM_EXPORT
+void chain_submit_history(chain_t chain, completion_queue_t queue, uint64_t user_id, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height);
+
+
+// Locators --------------------------------------------------------------------
+//Note: the locators are get_headers objects, the user releases them with chain_get_headers_destruct.
+
+//Note: the heights of a locator for the top height, dense near the top and then doubling the step (O(log top)).
+//      It is the user's responsibility to release the list returned.
+BITPRIM_EXPORT
+block_indexes_t chain_block_locator_heights(uint64_t /*size_t*/ top);
+
 BITPRIM_EXPORT
 void chain_fetch_block_locator(chain_t chain, void* ctx, block_indexes_t heights, block_locator_fetch_handler_t handler);
 
 BITPRIM_EXPORT
 int chain_get_block_locator(chain_t chain, block_indexes_t heights, get_headers_ptr_t* out_headers);
 
+//Note: the locator of the current tip. It is cached until the tip changes, checking it costs two lookups.
+BITPRIM_EXPORT
+void chain_fetch_tip_locator(chain_t chain, void* ctx, block_locator_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_tip_locator(chain_t chain, get_headers_ptr_t* out_headers);
+
+//Note: the hashes of the blocks following the first locator hash found in the chain, up to the threshold (excluded,
+//      null for none) and up to limit. out_hashes must hold limit hashes, the handler receives how many were written.
+BITPRIM_EXPORT
+void chain_fetch_locator_block_hashes(chain_t chain, void* ctx, get_blocks_t locator, hash_t threshold, uint64_t /*size_t*/ limit, hash_t* out_hashes, locator_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_locator_block_hashes(chain_t chain, get_blocks_t locator, hash_t threshold, uint64_t /*size_t*/ limit, hash_t* out_hashes, uint64_t /*size_t*/* out_count);
+
+//Note: same as chain_fetch_locator_block_hashes with the headers, written serialized (BITCOIN_HEADER_SIZE bytes each)
+//      into out_headers, which must hold limit headers. out_hashes (limit hashes) can be null.
+BITPRIM_EXPORT
+void chain_fetch_locator_block_headers(chain_t chain, void* ctx, get_headers_t locator, hash_t threshold, uint64_t /*size_t*/ limit, uint8_t* out_headers, hash_t* out_hashes, locator_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_locator_block_headers(chain_t chain, get_headers_t locator, hash_t threshold, uint64_t /*size_t*/ limit, uint8_t* out_headers, hash_t* out_hashes, uint64_t /*size_t*/* out_count);
+
 
 // ------------------------------------------------------------------
-//virtual void fetch_block_locator(const chain::block::indexes& heights, block_locator_fetch_handler handler) const = 0;
-//virtual void fetch_locator_block_hashes(get_blocks_const_ptr locator, const hash_digest& threshold, size_t limit, inventory_fetch_handler handler) const = 0;
-//virtual void fetch_locator_block_headers(get_headers_const_ptr locator, const hash_digest& threshold, size_t limit, locator_block_headers_fetch_handler handler) const = 0;
-//
 //// Transaction Pool.
 ////-------------------------------------------------------------------------
 //
 //virtual void fetch_template(merkle_block_fetch_handler handler) const = 0;
+//Note: see block_template.h for an incrementally updated template.
 //virtual void fetch_mempool(size_t count_limit, uint64_t minimum_fee, inventory_fetch_handler handler) const = 0;
+//Note: see mempool_index.h for the pool inventory ordered by fee rate.
 //
 //// Filters.
 ////-------------------------------------------------------------------------
@@ -179,6 +389,17 @@ int chain_get_block_locator(chain_t chain, block_indexes_t heights, get_headers_
 BITPRIM_EXPORT
 void chain_subscribe_blockchain(executor_t exec, chain_t chain, void* ctx, subscribe_blockchain_handler_t handler);
 
+//Note: the lists share the blocks with the blockchain (no copy), they must be released with chain_block_ptr_list_release.
+//      Either list can be null (no incoming or no replaced blocks), chain_block_ptr_list_count returns 0 for it.
+BITPRIM_EXPORT
+void chain_subscribe_blockchain_shared(executor_t exec, chain_t chain, void* ctx, subscribe_blockchain_shared_handler_t handler);
+
+//Note: only the fork height and the headers/hashes of the incoming and replaced blocks are delivered.
+BITPRIM_EXPORT
+void chain_subscribe_blockchain_headers(executor_t exec, chain_t chain, void* ctx, subscribe_blockchain_headers_handler_t handler);
+
+//Note: every accepted transaction is copied, see chain_subscribe_transaction_filtered (transaction_filter.h)
+//      to receive only the ones matching a watchlist.
 BITPRIM_EXPORT
 void chain_subscribe_transaction(executor_t exec, chain_t chain, void* ctx, subscribe_transaction_handler_t handler);
 
@@ -211,9 +432,65 @@ BITPRIM_EXPORT
 transaction_t hex_to_tx(char const* tx_hex);
 
 
+//Note: the error message is only valid during the handler call.
 BITPRIM_EXPORT
 void chain_validate_tx(chain_t chain, void* ctx, transaction_t tx, validate_tx_handler_t handler);
 
+//Note: the transactions are copied and organized in order on the executor worker threads, this returns at once.
+//      They are not validated concurrently, the transaction organizer serializes them. out_errors (count elements)
+//      receives the error code of each one, the handler is called once, when all the transactions were validated.
+BITPRIM_EXPORT
+void chain_validate_tx_batch(chain_t chain, void* ctx, transaction_t const* txs, uint64_t /*size_t*/ count, int* out_errors, validate_tx_batch_handler_t handler);
+
+//Note: returns the number of invalid transactions.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_validate_tx_batch_sync(chain_t chain, transaction_t const* txs, uint64_t /*size_t*/ count, int* out_errors);
+
+
+// Arena allocated results ----------------------------------------------------------
+//Note: the results are owned by the arena (see nodecint/arena.h) and released with nodecint_arena_reset,
+//      they must not be passed to their *_destruct function. A null arena behaves like the functions above.
+BITPRIM_EXPORT
+void chain_fetch_block_header_by_height_arena(chain_t chain, void* ctx, nodecint_arena_t arena, uint64_t /*size_t*/ height, block_header_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_header_by_height_arena(chain_t chain, nodecint_arena_t arena, uint64_t /*size_t*/ height, header_t* out_header, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_block_header_by_hash_arena(chain_t chain, void* ctx, nodecint_arena_t arena, hash_t hash, block_header_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_header_by_hash_arena(chain_t chain, nodecint_arena_t arena, hash_t hash, header_t* out_header, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_block_by_height_arena(chain_t chain, void* ctx, nodecint_arena_t arena, uint64_t /*size_t*/ height, block_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_by_height_arena(chain_t chain, nodecint_arena_t arena, uint64_t /*size_t*/ height, block_t* out_block, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_block_by_hash_arena(chain_t chain, void* ctx, nodecint_arena_t arena, hash_t hash, block_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_block_by_hash_arena(chain_t chain, nodecint_arena_t arena, hash_t hash, block_t* out_block, uint64_t /*size_t*/* out_height);
+
+BITPRIM_EXPORT
+void chain_fetch_transaction_arena(chain_t chain, void* ctx, nodecint_arena_t arena, hash_t hash, int require_confirmed, transaction_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_transaction_arena(chain_t chain, nodecint_arena_t arena, hash_t hash, int require_confirmed, transaction_t* out_transaction, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index);
+
+BITPRIM_EXPORT
+void chain_fetch_spend_arena(chain_t chain, void* ctx, nodecint_arena_t arena, output_point_t op, spend_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_spend_arena(chain_t chain, nodecint_arena_t arena, output_point_t op, input_point_t* out_input_point);
+
+BITPRIM_EXPORT
+void chain_fetch_history_arena(chain_t chain, void* ctx, nodecint_arena_t arena, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_fetch_handler_t handler);
+
+BITPRIM_EXPORT
+int chain_get_history_arena(chain_t chain, nodecint_arena_t arena, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_compact_list_t* out_history);
 
 
 #ifdef __cplusplus
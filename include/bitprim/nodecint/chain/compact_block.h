@@ -53,6 +53,13 @@ uint64_t compact_block_nonce(compact_block_t block);
 BITPRIM_EXPORT
 void compact_block_destruct(compact_block_t block);
 
+//Note: the returned block is read-only, it is valid until the handle is released.
+BITPRIM_EXPORT
+compact_block_t compact_block_ptr_get(compact_block_ptr_t block);
+
+BITPRIM_EXPORT
+void compact_block_ptr_release(compact_block_ptr_t block);
+
 BITPRIM_EXPORT
 void compact_block_reset(compact_block_t block);
 
@@ -34,6 +34,10 @@ extern "C" {
 BITPRIM_EXPORT
 hash_list_t chain_hash_list_construct_default(void);
 
+//Note: buffer holds count packed hashes (BITCOIN_HASH_SIZE bytes each).
+BITPRIM_EXPORT
+hash_list_t chain_hash_list_construct_from_buffer(uint8_t const* buffer, uint64_t /*size_t*/ count);
+
 BITPRIM_EXPORT
 void chain_hash_list_push_back(hash_list_t list, hash_t hash);
 
@@ -49,6 +53,10 @@ hash_t chain_hash_list_nth(hash_list_t list, uint64_t /*size_t*/ n);
 BITPRIM_EXPORT
 void chain_hash_list_nth_out(hash_list_t list, uint64_t /*size_t*/ n, hash_t* out_hash);
 
+//Note: copies up to capacity packed hashes into buffer, returns how many were copied.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_hash_list_copy_to(hash_list_t list, uint8_t* buffer, uint64_t /*size_t*/ capacity);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -63,6 +63,13 @@ header_t chain_header_construct(uint32_t version, uint8_t* previous_block_hash,
 BITPRIM_EXPORT
 void chain_header_destruct(header_t header);
 
+//Note: the returned header is read-only, it is valid until the handle is released.
+BITPRIM_EXPORT
+header_t chain_header_ptr_get(header_ptr_t header);
+
+BITPRIM_EXPORT
+void chain_header_ptr_release(header_ptr_t header);
+
 BITPRIM_EXPORT
 int chain_header_is_valid(header_t header);
 
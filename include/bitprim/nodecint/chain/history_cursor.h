@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_CHAIN_HISTORY_CURSOR_H_
+#define BITPRIM_NODECINT_CHAIN_HISTORY_CURSOR_H_
+
+//#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BITPRIM_EXPORT
+void chain_history_cursor_destruct(history_cursor_t cursor);
+
+//Note: total number of entries, including the ones already paged out.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_history_cursor_count(history_cursor_t cursor);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_history_cursor_remaining(history_cursor_t cursor);
+
+//Note: moves up to page_size entries into a new list and advances the cursor, returns 0 when there are no entries left.
+//      It is the user's responsibility to release the page returned.
+BITPRIM_EXPORT
+int /*bool*/ chain_history_cursor_next(history_cursor_t cursor, uint64_t /*size_t*/ page_size, history_compact_list_t* out_page);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_CHAIN_HISTORY_CURSOR_H_ */
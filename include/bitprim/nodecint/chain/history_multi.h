@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_CHAIN_HISTORY_MULTI_H_
+#define BITPRIM_NODECINT_CHAIN_HISTORY_MULTI_H_
+
+//#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BITPRIM_EXPORT
+void chain_history_multi_destruct(history_multi_t history);
+
+//Note: the returned list is read-only and it is owned by history, do not destruct it.
+BITPRIM_EXPORT
+history_compact_list_t chain_history_multi_list(history_multi_t history);
+
+//Note: the index (in the queried address array) of each element of the list.
+BITPRIM_EXPORT
+uint32_t const* chain_history_multi_address_indexes(history_multi_t history);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_history_multi_address_count(history_multi_t history);
+
+//Note: error of the lookup of one address, its entries are missing from the list if it is not 0.
+BITPRIM_EXPORT
+int chain_history_multi_error(history_multi_t history, uint64_t /*size_t*/ address_index);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_CHAIN_HISTORY_MULTI_H_ */
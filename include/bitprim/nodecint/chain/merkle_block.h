@@ -54,6 +54,13 @@ uint64_t /*size_t*/ chain_merkle_block_total_transaction_count(merkle_block_t bl
 BITPRIM_EXPORT
 void chain_merkle_block_destruct(merkle_block_t block);
 
+//Note: the returned block is read-only, it is valid until the handle is released.
+BITPRIM_EXPORT
+merkle_block_t chain_merkle_block_ptr_get(merkle_block_ptr_t block);
+
+BITPRIM_EXPORT
+void chain_merkle_block_ptr_release(merkle_block_ptr_t block);
+
 BITPRIM_EXPORT
 void chain_merkle_block_reset(merkle_block_t block);
 
@@ -45,6 +45,10 @@ uint32_t chain_point_get_index(point_t point);
 BITPRIM_EXPORT
 uint64_t chain_point_get_checksum(point_t point);
 
+//Note: also releases the input_point_t received from chain_fetch_spend.
+BITPRIM_EXPORT
+void chain_point_destruct(point_t point);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -30,6 +30,10 @@
 extern "C" {
 #endif
 
+//Note: buffer holds count serialized points (BITCOIN_POINT_SIZE bytes each, the hash and the little endian index).
+BITPRIM_EXPORT
+point_list_t point_list_construct_from_buffer(uint8_t const* buffer, uint64_t /*size_t*/ count);
+
 BITPRIM_EXPORT
 point_t point_list_nth(point_list_t point_list, uint64_t /*size_t*/ n);
 
@@ -39,6 +43,10 @@ uint64_t /*size_t*/ point_list_count(point_list_t point_list);
 BITPRIM_EXPORT
 void point_list_destruct(point_list_t point_list);
 
+//Note: serializes up to capacity points into buffer, returns how many were written.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ point_list_copy_to(point_list_t point_list, uint8_t* buffer, uint64_t /*size_t*/ capacity);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -40,9 +40,20 @@ transaction_t chain_transaction_construct_default(void);
 BITPRIM_EXPORT
 transaction_t chain_transaction_construct(uint32_t version, uint32_t locktime, input_list_t inputs, output_list_t outputs);
 
+//Note: deserializes the transaction directly from the caller buffer (n bytes), returns NULL if it is not a valid transaction.
+BITPRIM_EXPORT
+transaction_t chain_transaction_factory_from_data(uint32_t version, uint8_t const* data, uint64_t /*size_t*/ n);
+
 BITPRIM_EXPORT
 void chain_transaction_destruct(transaction_t transaction);
 
+//Note: the returned transaction is read-only, it is valid until the handle is released.
+BITPRIM_EXPORT
+transaction_t chain_transaction_ptr_get(transaction_ptr_t transaction);
+
+BITPRIM_EXPORT
+void chain_transaction_ptr_release(transaction_ptr_t transaction);
+
 BITPRIM_EXPORT
 int chain_transaction_is_valid(transaction_t transaction);
 
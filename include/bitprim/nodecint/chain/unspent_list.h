@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_CHAIN_UNSPENT_LIST_H_
+#define BITPRIM_NODECINT_CHAIN_UNSPENT_LIST_H_
+
+//#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BITPRIM_EXPORT
+void chain_unspent_list_destruct(unspent_list_t list);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_unspent_list_count(unspent_list_t list);
+
+//Note: the count outputs are contiguous, the pointer is valid until the list is destructed.
+BITPRIM_EXPORT
+unspent_output_t const* chain_unspent_list_data(unspent_list_t list);
+
+BITPRIM_EXPORT
+unspent_output_t chain_unspent_list_nth(unspent_list_t list, uint64_t /*size_t*/ n);
+
+//Note: sum of the values of the unspent outputs.
+BITPRIM_EXPORT
+uint64_t chain_unspent_list_balance(unspent_list_t list);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_CHAIN_UNSPENT_LIST_H_ */
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_COMPLETION_QUEUE_H_
+#define BITPRIM_NODECINT_COMPLETION_QUEUE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Note: The queue must outlive every request submitted to it.
+BITPRIM_EXPORT
+completion_queue_t completion_queue_construct(void);
+
+BITPRIM_EXPORT
+void completion_queue_destruct(completion_queue_t queue);
+
+//Note: The descriptor is readable while there are completions in the queue (it can be registered in epoll/poll/select).
+//      Returns -1 on platforms without descriptor support, completion_queue_pop must be polled there.
+BITPRIM_EXPORT
+int completion_queue_fd(completion_queue_t queue);
+
+//Note: Non-blocking, moves up to max completions into out_completions and returns how many were moved.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ completion_queue_pop(completion_queue_t queue, completion_t* out_completions, uint64_t /*size_t*/ max);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ completion_queue_count(completion_queue_t queue);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_COMPLETION_QUEUE_H_ */
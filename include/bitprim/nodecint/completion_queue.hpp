@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_COMPLETION_QUEUE_HPP_
+#define BITPRIM_NODECINT_COMPLETION_QUEUE_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+#include <bitprim/nodecint/primitives.h>
+
+namespace bitprim { namespace nodecint {
+
+class completion_queue
+{
+public:
+    completion_queue();
+    ~completion_queue();
+
+    completion_queue(completion_queue const&) = delete;
+    void operator=(completion_queue const&) = delete;
+
+    int fd() const;
+    size_t size() const;
+
+    void push(completion_t const& completion);
+    size_t pop(completion_t* out_completions, size_t max);
+
+private:
+    void signal();
+    void drain();
+
+    mutable std::mutex mutex_;
+    std::deque<completion_t> completions_;
+    int read_fd_;
+    int write_fd_;
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_COMPLETION_QUEUE_HPP_ */
@@ -27,20 +27,41 @@
 #include <bitcoin/bitcoin/chain/output_point.hpp>
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/message/block.hpp>
+#include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/get_blocks.hpp>
+#include <bitcoin/bitcoin/message/get_headers.hpp>
 #include <bitcoin/bitcoin/message/header.hpp>
+#include <bitcoin/bitcoin/message/merkle_block.hpp>
 #include <bitcoin/bitcoin/message/transaction.hpp>
 
 libbitcoin::message::block const& chain_block_const_cpp(block_t block);
 libbitcoin::message::block& chain_block_cpp(block_t block);
 
+//Note: returns nullptr if block is not set. It is the responsability of the user to release the handle.
+block_ptr_t chain_block_ptr_construct_from_cpp(libbitcoin::message::block::const_ptr const& block);
+libbitcoin::message::block::const_ptr const& chain_block_ptr_const_cpp(block_ptr_t block);
+
+compact_block_ptr_t compact_block_ptr_construct_from_cpp(libbitcoin::message::compact_block::const_ptr const& block);
+libbitcoin::message::compact_block::const_ptr const& compact_block_ptr_const_cpp(compact_block_ptr_t block);
+
+merkle_block_ptr_t chain_merkle_block_ptr_construct_from_cpp(libbitcoin::message::merkle_block::const_ptr const& block);
+libbitcoin::message::merkle_block::const_ptr const& chain_merkle_block_ptr_const_cpp(merkle_block_ptr_t block);
+
 std::vector<libbitcoin::message::block> const& chain_block_list_const_cpp(block_list_t list);
 std::vector<libbitcoin::message::block>& chain_block_list_cpp(block_list_t list);
+
+//Note: returns nullptr if list is not set. It is the responsability of the user to release the handle.
+block_ptr_list_t chain_block_ptr_list_construct_from_cpp(libbitcoin::message::block::const_ptr_list_const_ptr const& list);
+libbitcoin::message::block::const_ptr_list_const_ptr const& chain_block_ptr_list_const_cpp(block_ptr_list_t list);
 //Note: block_list_t created with this function has not have to destruct it...
 //block_list_t chain_block_list_construct_from_cpp(libbitcoin::message::block::list& list);
 
 libbitcoin::message::header const& chain_header_const_cpp(header_t header);
 libbitcoin::message::header& chain_header_cpp(header_t header);
 
+header_ptr_t chain_header_ptr_construct_from_cpp(libbitcoin::message::header::const_ptr const& header);
+libbitcoin::message::header::const_ptr const& chain_header_ptr_const_cpp(header_ptr_t header);
+
 libbitcoin::chain::input const& chain_input_const_cpp(input_t input);
 libbitcoin::chain::input& chain_input_cpp(input_t input);
 
@@ -70,6 +91,9 @@ libbitcoin::chain::script& chain_script_cpp(script_t s);
 libbitcoin::message::transaction const& chain_transaction_const_cpp(transaction_t transaction);
 libbitcoin::message::transaction& chain_transaction_cpp(transaction_t transaction);
 
+transaction_ptr_t chain_transaction_ptr_construct_from_cpp(libbitcoin::message::transaction::const_ptr const& transaction);
+libbitcoin::message::transaction::const_ptr const& chain_transaction_ptr_const_cpp(transaction_ptr_t transaction);
+
 
 
 std::vector<libbitcoin::message::transaction> const& chain_transaction_list_const_cpp(transaction_list_t list);
@@ -86,5 +110,8 @@ hash_list_t chain_hash_list_construct_from_cpp(std::vector<libbitcoin::hash_dige
 std::vector<uint64_t /*size_t*/> const& chain_block_indexes_const_cpp(block_indexes_t list);
 std::vector<uint64_t /*size_t*/>& chain_block_indexes_cpp(block_indexes_t list);
 
+libbitcoin::message::get_blocks const& chain_get_blocks_const_cpp(get_blocks_t get_b);
+libbitcoin::message::get_headers const& chain_get_headers_const_cpp(get_headers_t get_b);
+
 
 #endif /* BITPRIM_NODECINT_CONVERTIONS_HPP_ */
@@ -80,6 +80,25 @@ p2p_t executor_get_p2p(executor_t exec);
 BITPRIM_EXPORT
 char const* executor_version();
 
+//Note: the API statistics are per process, shared by every executor. Each chain_* function has its entry
+//      from its first call on. Writes up to capacity entries and returns the number of entries, the names are
+//      valid until the process ends.
+BITPRIM_EXPORT
+uint64_t /*size_t*/ executor_get_api_stats(executor_t exec, api_stats_t* out_stats, uint64_t /*size_t*/ capacity);
+
+//Note: writes the API statistics in the Prometheus text format, returns 0 on success.
+BITPRIM_EXPORT
+int executor_dump_api_stats(executor_t exec, char const* path);
+
+#if ! defined(_WIN32)
+
+//Note: sends the API statistics in the Prometheus text format to a local (unix) stream socket, returns 0 on success.
+//      A peer closing the socket early makes it return 1, it never raises SIGPIPE.
+BITPRIM_EXPORT
+int executor_send_api_stats(executor_t exec, char const* socket_path);
+
+#endif /* ! defined(_WIN32) */
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_HEX_H_
+#define BITPRIM_NODECINT_HEX_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Note: decodes hex_size characters (it must be even) into out_data, which must hold hex_size / 2 bytes.
+//      Returns 1 on success, 0 if the string is not valid hex.
+BITPRIM_EXPORT
+int /*bool*/ hex_decode(char const* hex, uint64_t /*size_t*/ hex_size, uint8_t* out_data);
+
+//Note: out_hex must hold 2 * n + 1 characters, the result is null terminated.
+BITPRIM_EXPORT
+void hex_encode(uint8_t const* data, uint64_t /*size_t*/ n, char* out_hex);
+
+//Note: hashes are encoded in the bitcoin display order (reversed bytes), as libbitcoin::encode_hash.
+BITPRIM_EXPORT
+int /*bool*/ hex_to_hash(char const* hex, hash_t* out_hash);
+
+//Note: out_hex must hold 2 * BITCOIN_HASH_SIZE + 1 characters.
+BITPRIM_EXPORT
+void hash_to_hex(hash_t hash, char* out_hex);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_HEX_H_ */
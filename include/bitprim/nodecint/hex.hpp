@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_HEX_HPP_
+#define BITPRIM_NODECINT_HEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bitprim { namespace hex {
+
+// Each codec converts n bytes, from/to 2 * n characters.
+// decode returns false if any character is not an hex digit.
+using decode_function = bool (*)(char const* hex, size_t n, uint8_t* out);
+using encode_function = void (*)(uint8_t const* data, size_t n, char* out);
+
+bool decode_scalar(char const* hex, size_t n, uint8_t* out);
+void encode_scalar(uint8_t const* data, size_t n, char* out);
+
+// Vectorized codecs, null if they are not available on the running CPU.
+decode_function decode_ssse3();
+encode_function encode_ssse3();
+decode_function decode_avx2();
+encode_function encode_avx2();
+
+// Best codec available on the running CPU.
+bool decode(char const* hex, size_t n, uint8_t* out);
+void encode(uint8_t const* data, size_t n, char* out);
+
+} // namespace hex
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_HEX_HPP_ */
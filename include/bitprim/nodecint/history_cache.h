@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_HISTORY_CACHE_H_
+#define BITPRIM_NODECINT_HISTORY_CACHE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Note: LRU cache of address histories keyed by (address, limit, from_height), bounded by memory_budget bytes.
+//      Entries are invalidated by the blocks (including reorganizations) and the transactions touching their address.
+//      The chain must be running.
+BITPRIM_EXPORT
+history_cache_t history_cache_construct(chain_t chain, uint64_t /*size_t*/ memory_budget);
+
+BITPRIM_EXPORT
+void history_cache_destruct(history_cache_t cache);
+
+//It is the user's responsibility to release the history returned in the callback
+BITPRIM_EXPORT
+void history_cache_fetch_history(history_cache_t cache, void* ctx, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_fetch_handler_t handler);
+
+//It is the user's responsibility to release the history returned
+BITPRIM_EXPORT
+int history_cache_get_history(history_cache_t cache, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_compact_list_t* out_history);
+
+//Note: memoized along with the whole history of the address (limit and from_height 0), until a block,
+//      a reorganization or a transaction touches the address.
+//      It is the user's responsibility to release the unspent outputs returned in the callback
+BITPRIM_EXPORT
+void history_cache_fetch_unspent_outputs(history_cache_t cache, void* ctx, payment_address_t address, unspent_fetch_handler_t handler);
+
+//It is the user's responsibility to release the unspent outputs returned
+BITPRIM_EXPORT
+int history_cache_get_unspent_outputs(history_cache_t cache, payment_address_t address, unspent_list_t* out_unspent);
+
+//Note: out_balances (count elements) receives the balance of each address, returns the first error.
+BITPRIM_EXPORT
+int history_cache_get_balances(history_cache_t cache, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t* out_balances);
+
+BITPRIM_EXPORT
+void history_cache_stats(history_cache_t cache, history_cache_stats_t* out_stats);
+
+BITPRIM_EXPORT
+void history_cache_clear(history_cache_t cache);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_HISTORY_CACHE_H_ */
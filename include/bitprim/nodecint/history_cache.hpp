@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_HISTORY_CACHE_HPP_
+#define BITPRIM_NODECINT_HISTORY_CACHE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include <bitprim/nodecint/primitives.h>
+#include <bitprim/nodecint/unspent_list.hpp>
+
+#include <bitcoin/bitcoin/chain/history.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+#include <bitcoin/blockchain/interface/safe_chain.hpp>
+
+namespace bitprim { namespace nodecint {
+
+class history_cache
+{
+public:
+    using history_ptr = std::shared_ptr<libbitcoin::chain::history_compact::list const>;
+    using fetch_handler = std::function<void(libbitcoin::code const&, history_ptr)>;
+    using unspent_ptr = std::shared_ptr<unspent_list const>;
+    using unspent_handler = std::function<void(libbitcoin::code const&, unspent_ptr)>;
+
+    history_cache(libbitcoin::blockchain::safe_chain& chain, size_t memory_budget);
+    ~history_cache();
+
+    history_cache(history_cache const&) = delete;
+    void operator=(history_cache const&) = delete;
+
+    libbitcoin::blockchain::safe_chain& chain();
+
+    void fetch_history(libbitcoin::wallet::payment_address const& address, size_t limit, size_t from_height, fetch_handler handler);
+
+    // Computed from the whole history (limit and from_height 0) and kept along with its entry.
+    void fetch_unspent(libbitcoin::wallet::payment_address const& address, unspent_handler handler);
+
+    history_cache_stats_t stats() const;
+    void clear();
+
+private:
+    class store;
+
+    libbitcoin::blockchain::safe_chain& chain_;
+
+    // Shared with the chain subscriptions and the in-flight fetches, which can outlive the cache.
+    std::shared_ptr<store> store_;
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_HISTORY_CACHE_HPP_ */
@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_HISTORY_CURSOR_HPP_
+#define BITPRIM_NODECINT_HISTORY_CURSOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include <bitcoin/bitcoin/chain/history.hpp>
+
+namespace bitprim { namespace nodecint {
+
+// The entries of the history not paged out yet, in reverse order: the pages are taken from the back.
+// The vector returned by the block chain is kept (moved, never copied) and shrunk as it is paged out.
+//Note: the block chain returns the whole history at once, so the peak memory is still the whole history.
+struct history_cursor {
+    explicit history_cursor(libbitcoin::chain::history_compact::list history)
+        : entries(std::move(history))
+        , count(entries.size())
+    {
+        std::reverse(entries.begin(), entries.end());
+    }
+
+    libbitcoin::chain::history_compact::list entries;
+    size_t count;
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_HISTORY_CURSOR_HPP_ */
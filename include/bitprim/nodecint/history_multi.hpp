@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_HISTORY_MULTI_HPP_
+#define BITPRIM_NODECINT_HISTORY_MULTI_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <bitcoin/bitcoin/chain/history.hpp>
+
+namespace bitprim { namespace nodecint {
+
+// Merged result of a multi-address history query.
+struct history_multi {
+    libbitcoin::chain::history_compact::list entries;
+    std::vector<uint32_t> address_indexes;      // one per entry
+    std::vector<int> errors;                    // one per queried address
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_HISTORY_MULTI_HPP_ */
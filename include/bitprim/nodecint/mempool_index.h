@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_MEMPOOL_INDEX_H_
+#define BITPRIM_NODECINT_MEMPOOL_INDEX_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Note: Mirror of the transaction pool, fed by the transactions accepted and the blocks organized after it is constructed.
+//      Every addition and removal gets the next sequence number, the last change_history ones are kept for
+//      mempool_index_changes. Over max_count transactions (0 means no cap) the lowest fee rates are evicted,
+//      as removal changes. A reorganization puts the transactions of the replaced blocks back.
+//      The chain must be running.
+BITPRIM_EXPORT
+mempool_index_t mempool_index_construct(chain_t chain, uint64_t /*size_t*/ change_history, uint64_t /*size_t*/ max_count);
+
+BITPRIM_EXPORT
+void mempool_index_destruct(mempool_index_t index);
+
+BITPRIM_EXPORT
+uint64_t mempool_index_sequence(mempool_index_t index);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ mempool_index_count(mempool_index_t index);
+
+//Note: up to count_limit (0 means no limit) transactions paying at least minimum_fee, highest fee rate first.
+//      chain_mempool_entry_list_sequence gives the sequence to pass to mempool_index_changes afterwards.
+//      It is the user's responsibility to release the list returned.
+BITPRIM_EXPORT
+mempool_entry_list_t mempool_index_snapshot(mempool_index_t index, uint64_t /*size_t*/ count_limit, uint64_t minimum_fee);
+
+//Note: the additions and removals after since_sequence, oldest first. Returns 0 (and no list) when some of them
+//      were already discarded, the caller must take a new snapshot.
+//      It is the user's responsibility to release the list returned.
+BITPRIM_EXPORT
+int /*bool*/ mempool_index_changes(mempool_index_t index, uint64_t since_sequence, mempool_entry_list_t* out_changes);
+
+BITPRIM_EXPORT
+void chain_mempool_entry_list_destruct(mempool_entry_list_t list);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ chain_mempool_entry_list_count(mempool_entry_list_t list);
+
+//Note: the count entries are contiguous, the pointer is valid until the list is destructed.
+BITPRIM_EXPORT
+mempool_entry_t const* chain_mempool_entry_list_data(mempool_entry_list_t list);
+
+BITPRIM_EXPORT
+uint64_t chain_mempool_entry_list_sequence(mempool_entry_list_t list);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_MEMPOOL_INDEX_H_ */
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_MEMPOOL_INDEX_HPP_
+#define BITPRIM_NODECINT_MEMPOOL_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <bitprim/nodecint/primitives.h>
+
+#include <bitcoin/blockchain/interface/safe_chain.hpp>
+
+namespace bitprim { namespace nodecint {
+
+struct mempool_entry_list {
+    std::vector<mempool_entry_t> entries;
+    uint64_t sequence;
+};
+
+class mempool_index
+{
+public:
+    // A max_count of 0 means no size cap.
+    mempool_index(libbitcoin::blockchain::safe_chain& chain, size_t change_history, size_t max_count);
+    ~mempool_index();
+
+    mempool_index(mempool_index const&) = delete;
+    void operator=(mempool_index const&) = delete;
+
+    uint64_t sequence() const;
+    size_t count() const;
+
+    mempool_entry_list snapshot(size_t count_limit, uint64_t minimum_fee) const;
+    bool changes(uint64_t since_sequence, mempool_entry_list& out_changes) const;
+
+private:
+    class store;
+
+    // Shared with the chain subscriptions, which can outlive the index.
+    std::shared_ptr<store> store_;
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_MEMPOOL_INDEX_HPP_ */
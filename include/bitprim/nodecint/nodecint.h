@@ -32,7 +32,15 @@
 #include <bitprim/nodecint/version.h>
 #include <bitprim/nodecint/executor_c.h>
 
+#include <bitprim/nodecint/arena.h>
 #include <bitprim/nodecint/binary.h>
+#include <bitprim/nodecint/block_template.h>
+#include <bitprim/nodecint/completion_queue.h>
+#include <bitprim/nodecint/hex.h>
+#include <bitprim/nodecint/history_cache.h>
+#include <bitprim/nodecint/mempool_index.h>
+#include <bitprim/nodecint/stealth_index.h>
+#include <bitprim/nodecint/transaction_filter.h>
 
 #include <bitprim/nodecint/chain/block.h>
 #include <bitprim/nodecint/chain/block_list.h>
@@ -41,6 +49,8 @@
 #include <bitprim/nodecint/chain/header.h>
 #include <bitprim/nodecint/chain/history_compact.h>
 #include <bitprim/nodecint/chain/history_compact_list.h>
+#include <bitprim/nodecint/chain/history_cursor.h>
+#include <bitprim/nodecint/chain/history_multi.h>
 #include <bitprim/nodecint/chain/stealth_compact.h>
 #include <bitprim/nodecint/chain/stealth_compact_list.h>
 #include <bitprim/nodecint/chain/input.h>
@@ -55,6 +65,7 @@
 #include <bitprim/nodecint/chain/script.h>
 #include <bitprim/nodecint/chain/transaction.h>
 #include <bitprim/nodecint/chain/transaction_list.h>
+#include <bitprim/nodecint/chain/unspent_list.h>
 
 #include <bitprim/nodecint/p2p/p2p.h>
 
@@ -36,6 +36,8 @@ extern "C" {
 #define BITCOIN_SHORT_HASH_SIZE 20
 #define BITCOIN_HASH_SIZE 32
 #define BITCOIN_LONG_HASH_SIZE 64
+#define BITCOIN_HEADER_SIZE 80
+#define BITCOIN_POINT_SIZE 36
 
 
 typedef enum point_kind {output = 0, spend = 1} point_kind_t;
@@ -43,6 +45,16 @@ typedef enum point_kind {output = 0, spend = 1} point_kind_t;
 typedef struct executor* executor_t;
 typedef void* chain_t;
 typedef void* p2p_t;
+typedef void* completion_queue_t;
+typedef void* history_cache_t;
+typedef void* nodecint_arena_t;
+typedef void* mempool_index_t;
+typedef void* mempool_entry_list_t;
+typedef void* block_template_t;
+typedef void* block_template_snapshot_t;
+typedef void* transaction_filter_t;
+typedef void* transaction_subscription_t;
+typedef void* stealth_index_t;
 
 //typedef struct output_point_t {
 //    uint8_t* hash;
@@ -59,6 +71,9 @@ typedef void* compact_block_t;
 typedef void* header_t;
 typedef void* history_compact_t;
 typedef void* history_compact_list_t;
+typedef void* history_multi_t;
+typedef void* history_cursor_t;
+typedef void* unspent_list_t;
 
 typedef void* input_t;
 typedef void* input_list_t;
@@ -90,6 +105,15 @@ typedef void* stealth_compact_list_t;
 
 typedef void* hash_list_t;
 
+//Note: *_ptr_t handles share ownership of the objects held by the blockchain (no deep copy).
+//      They must be released with the corresponding *_ptr_release function.
+typedef void* block_ptr_t;
+typedef void* block_ptr_list_t;
+typedef void* compact_block_ptr_t;
+typedef void* header_ptr_t;
+typedef void* merkle_block_ptr_t;
+typedef void* transaction_ptr_t;
+
 
 
 //typedef uint8_t const* hash_t;
@@ -113,20 +137,143 @@ typedef struct long_hash_t {
     uint8_t hash[BITCOIN_LONG_HASH_SIZE];
 } long_hash_t;
 
+typedef struct unspent_output_t {
+    hash_t hash;
+    uint32_t index;
+    uint64_t height;
+    uint64_t value;
+} unspent_output_t;
+
+//Note: removed is not 0 for the changes that took the transaction out of the pool (mined or double spent).
+typedef struct mempool_entry_t {
+    hash_t hash;
+    uint64_t size;
+    uint64_t fee;
+    uint64_t sequence;
+    int removed;
+} mempool_entry_t;
+
+//Note: build latencies in microseconds.
+typedef struct block_template_stats_t {
+    uint64_t full_builds;
+    uint64_t incremental_updates;
+    uint64_t last_full_build_us;
+    uint64_t max_full_build_us;
+    uint64_t last_incremental_us;
+    uint64_t max_incremental_us;
+    uint64_t pool_size;
+    uint64_t selected;
+    uint64_t evicted;
+} block_template_stats_t;
+
+//Note: latencies in nanoseconds, the percentiles are upper bounds with about 6% precision.
+//      latency is from the call to the callback, blocked is the time the sync variants wait for the result.
+typedef struct api_stats_t {
+    char const* name;
+    uint64_t calls;
+    uint64_t latency_sum;
+    uint64_t latency_max;
+    uint64_t latency_p50;
+    uint64_t latency_p90;
+    uint64_t latency_p99;
+    uint64_t latency_p999;
+    uint64_t blocked_calls;
+    uint64_t blocked_sum;
+    uint64_t blocked_max;
+    uint64_t blocked_p99;
+} api_stats_t;
+
+#define BITPRIM_MERKLE_PROOF_MAX_BRANCH 32
+
+//Note: branch[0] is the sibling of the transaction, branch[branch_count - 1] the sibling just below the root.
+//      Bit i of index tells the side at level i (1 means the branch hash is on the left).
+typedef struct merkle_proof_t {
+    hash_t block_hash;
+    hash_t merkle_root;
+    uint64_t height;
+    uint64_t index;
+    uint64_t branch_count;
+    hash_t branch[BITPRIM_MERKLE_PROOF_MAX_BRANCH];
+} merkle_proof_t;
+
 //typedef char const* zstring_t;
 typedef void* word_list_t;
 
+// Struct-of-arrays view of a block, see chain_block_to_columnar.
+// The counts are the number of elements of each column, the columns are caller allocated (NULL columns are skipped).
+typedef struct block_columnar_t {
+    uint64_t /*size_t*/ transaction_count;
+    uint64_t /*size_t*/ input_count;
+    uint64_t /*size_t*/ output_count;
+    uint64_t /*size_t*/ script_size;
+
+    hash_t* txids;                      // transaction_count
+    uint32_t* transaction_input_counts; // transaction_count
+    uint32_t* transaction_output_counts;// transaction_count
+    hash_t* prevout_hashes;             // input_count
+    uint32_t* prevout_indexes;          // input_count
+    uint64_t* output_values;            // output_count
+    uint64_t* script_offsets;           // output_count + 1, the script of output i is [scripts + offsets[i], scripts + offsets[i + 1])
+    uint8_t* scripts;                   // script_size, output scripts without the length prefix
+} block_columnar_t;
+
+// Standard output script patterns, see chain_block_extract_output_destinations.
+typedef enum script_pattern {
+    script_pattern_non_standard = 0,
+    script_pattern_pay_key_hash = 1,
+    script_pattern_pay_script_hash = 2,
+    script_pattern_pay_public_key = 3,
+    script_pattern_pay_multisig = 4,
+    script_pattern_null_data = 5
+} script_pattern_t;
+
+//Note: hash is the key hash (P2PKH), the script hash (P2SH) or the hash160 of the key (P2PK), zeros for the other patterns.
+typedef struct output_destination_t {
+    uint32_t transaction_index;
+    uint32_t output_index;
+    script_pattern_t pattern;
+    uint8_t hash[BITCOIN_SHORT_HASH_SIZE];
+} output_destination_t;
+
+// Result of a request submitted to a completion queue.
+// The meaning of result, height and index depends on the submitted request.
+typedef struct completion_t {
+    uint64_t user_id;
+    int error;
+    void* result;
+    uint64_t /*size_t*/ height;
+    uint64_t /*size_t*/ index;
+} completion_t;
+
+typedef struct history_cache_stats_t {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;         // entries dropped to respect the memory budget
+    uint64_t invalidations;     // entries dropped by blocks and transactions touching their address
+    uint64_t /*size_t*/ entries;
+    uint64_t /*size_t*/ memory_usage;
+    uint64_t /*size_t*/ memory_budget;
+} history_cache_stats_t;
+
 
 
 typedef void (*run_handler_t)(executor_t exec, void* ctx, int error);
 
 
 typedef void (*stealth_fetch_handler_t)(chain_t chain, void*, int, stealth_compact_list_t stealth);
+typedef int (*stealth_chunk_handler_t)(stealth_index_t, void*, int, stealth_compact_list_t chunk, int /*bool*/ last);
 typedef void (*block_fetch_handler_t)(chain_t, void*, int, block_t block, uint64_t /*size_t*/ h);
 typedef void (*block_height_fetch_handler_t)(chain_t, void*, int, uint64_t /*size_t*/ h);
 typedef void (*block_header_fetch_handler_t)(chain_t, void*, int, header_t header, uint64_t /*size_t*/ h);
+typedef void (*block_headers_range_fetch_handler_t)(chain_t, void*, int, uint64_t /*size_t*/ count);
+typedef void (*block_raw_fetch_handler_t)(chain_t, void*, int, uint64_t /*size_t*/ size, uint64_t /*size_t*/ h);
+typedef void (*transaction_raw_fetch_handler_t)(chain_t, void*, int, uint64_t /*size_t*/ size, uint64_t /*size_t*/ i, uint64_t /*size_t*/ h);
 typedef void (*compact_block_fetch_handler_t)(chain_t, void*, int, compact_block_t block, uint64_t /*size_t*/ h);
 typedef void (*history_fetch_handler_t)(chain_t, void*, int, history_compact_list_t history);
+typedef void (*history_multi_fetch_handler_t)(chain_t, void*, int, history_multi_t history);
+typedef void (*history_cursor_fetch_handler_t)(chain_t, void*, int, history_cursor_t cursor);
+typedef void (*unspent_fetch_handler_t)(chain_t, void*, int, unspent_list_t unspent);
+typedef int (*history_chunk_handler_t)(chain_t, void*, int, history_compact_list_t chunk, int /*bool*/ last);
 typedef void (*last_height_fetch_handler_t)(chain_t, void*, int, uint64_t /*size_t*/ h);
 typedef void (*merkle_block_fetch_handler_t)(chain_t, void*, int, merkle_block_t block, uint64_t /*size_t*/ h);
 typedef void (*output_fetch_handler_t)(chain_t, void*, int, output_t output);
@@ -134,9 +281,17 @@ typedef void (*spend_fetch_handler_t)(chain_t, void*, int, input_point_t input_p
 typedef void (*transaction_fetch_handler_t)(chain_t, void*, int, transaction_t transaction, uint64_t /*size_t*/ i, uint64_t /*size_t*/ h);
 typedef void (*transaction_index_fetch_handler_t)(chain_t, void*, int, uint64_t /*size_t*/ position, uint64_t /*size_t*/ height);
 typedef void (*validate_tx_handler_t)(chain_t, void*, int, char const* message);
+typedef void (*validate_tx_batch_handler_t)(chain_t, void*, uint64_t /*size_t*/ invalid_count);
+
+typedef void (*block_ptr_fetch_handler_t)(chain_t, void*, int, block_ptr_t block, uint64_t /*size_t*/ h);
+typedef void (*block_header_ptr_fetch_handler_t)(chain_t, void*, int, header_ptr_t header, uint64_t /*size_t*/ h);
+typedef void (*compact_block_ptr_fetch_handler_t)(chain_t, void*, int, compact_block_ptr_t block, uint64_t /*size_t*/ h);
+typedef void (*merkle_block_ptr_fetch_handler_t)(chain_t, void*, int, merkle_block_ptr_t block, uint64_t /*size_t*/ h);
+typedef void (*transaction_ptr_fetch_handler_t)(chain_t, void*, int, transaction_ptr_t transaction, uint64_t /*size_t*/ i, uint64_t /*size_t*/ h);
 
 //typedef std::function<void(const code&, get_headers_ptr)> block_locator_fetch_handler;
 typedef void (*block_locator_fetch_handler_t)(chain_t, void*, int, get_headers_ptr_t);
+typedef void (*locator_fetch_handler_t)(chain_t, void*, int, uint64_t /*size_t*/ count);
 
 //typedef std::function<void(const code&, inventory_ptr)> inventory_fetch_handler;
 
@@ -144,6 +299,12 @@ typedef void (*block_locator_fetch_handler_t)(chain_t, void*, int, get_headers_p
 typedef void (*result_handler_t)(chain_t, void*, int);
 
 typedef int (*subscribe_blockchain_handler_t)(executor_t exec, chain_t, void*, int, uint64_t /*size_t*/, block_list_t, block_list_t);
+typedef int (*subscribe_blockchain_shared_handler_t)(executor_t exec, chain_t, void*, int, uint64_t /*size_t*/ fork_height, block_ptr_list_t incoming, block_ptr_list_t replaced);
+
+//Note: headers are serialized (BITCOIN_HEADER_SIZE bytes each), the buffers are only valid during the handler call.
+typedef int (*subscribe_blockchain_headers_handler_t)(executor_t exec, chain_t, void*, int, uint64_t /*size_t*/ fork_height,
+                                                      uint64_t /*size_t*/ incoming_count, uint8_t const* incoming_headers, hash_t const* incoming_hashes,
+                                                      uint64_t /*size_t*/ replaced_count, uint8_t const* replaced_headers, hash_t const* replaced_hashes);
 typedef int (*subscribe_transaction_handler_t)(executor_t exec, chain_t, void*, int, transaction_t);
 
 
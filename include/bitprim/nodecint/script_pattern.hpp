@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_SCRIPT_PATTERN_HPP_
+#define BITPRIM_NODECINT_SCRIPT_PATTERN_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bitprim/nodecint/primitives.h>
+
+namespace bitprim { namespace nodecint {
+
+// Pattern of a serialized output script (without its length prefix), matched on the bytes without parsing it.
+// out_hash gets the BITCOIN_SHORT_HASH_SIZE bytes hash of the key, the key hash or the script hash of the
+// single address patterns, it is not written for the others.
+script_pattern_t classify_output_script(uint8_t const* script, size_t size, uint8_t* out_hash);
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_SCRIPT_PATTERN_HPP_ */
@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_SHA256_HPP_
+#define BITPRIM_NODECINT_SHA256_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bitprim { namespace sha256 {
+
+// Same layout as libbitcoin::hash_digest.
+using digest = std::array<uint8_t, 32>;
+
+// Double SHA-256 of n bytes, 32 bytes out.
+using hash_function = void (*)(uint8_t const* data, size_t n, uint8_t* out);
+
+// Double SHA-256 of count inputs of 64 bytes each (a pair of merkle nodes), 32 * count bytes out.
+// out can be data itself, each group of inputs is read before its outputs are written.
+using hash64_function = void (*)(uint8_t const* data, size_t count, uint8_t* out);
+
+void double_hash_scalar(uint8_t const* data, size_t n, uint8_t* out);
+void double_hash64_scalar(uint8_t const* data, size_t count, uint8_t* out);
+
+// Backends using CPU extensions, null if they are not available on the running CPU.
+// The AVX2 one hashes 8 inputs at once, it is only used for the 64 bytes inputs.
+hash_function double_hash_shani();
+hash64_function double_hash64_shani();
+hash64_function double_hash64_avx2();
+
+// Name of the backend used by double_hash64 on the running CPU.
+char const* backend_name();
+
+// Best backend available on the running CPU.
+void double_hash(uint8_t const* data, size_t n, uint8_t* out);
+void double_hash64(uint8_t const* data, size_t count, uint8_t* out);
+
+// The (count + 1) / 2 parents of a merkle tree level, an odd last hash is paired with itself.
+// out can be hashes itself.
+void merkle_parents(digest const* hashes, size_t count, digest* out);
+
+// Merkle root of the transaction hashes, the null hash if there are none.
+digest merkle_root(std::vector<digest> hashes);
+
+} // namespace sha256
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_SHA256_HPP_ */
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_STEALTH_INDEX_H_
+#define BITPRIM_NODECINT_STEALTH_INDEX_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Note: In-memory stealth rows from from_height on, bucketed by prefix. The blocks organized after it is constructed
+//      are indexed by a chain subscription, stealth_index_build scans the ones before. The chain must be running.
+BITPRIM_EXPORT
+stealth_index_t stealth_index_construct(chain_t chain, uint64_t /*size_t*/ from_height);
+
+BITPRIM_EXPORT
+void stealth_index_destruct(stealth_index_t index);
+
+//Note: Blocking, reads the blocks from from_height to the top with threads workers (0 means one per core).
+//      It succeeds only once, the queries return the rows of the scanned blocks after it returns.
+//      After a failure (a block read error stops all the workers) it can be called again.
+BITPRIM_EXPORT
+int stealth_index_build(stealth_index_t index, uint64_t /*size_t*/ threads);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ stealth_index_count(stealth_index_t index);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ stealth_index_height(stealth_index_t index);
+
+//Note: The same rows as chain_fetch_stealth, sorted by prefix and then by height. Calls handler with consecutive chunks
+//      of up to chunk_size rows until the last one (last != 0) or until it returns 0.
+//      The chunk is owned by the library and only valid during the call, do not destruct it.
+BITPRIM_EXPORT
+void stealth_index_fetch(stealth_index_t index, void* ctx, binary_t filter, uint64_t from_height, uint64_t /*size_t*/ chunk_size, stealth_chunk_handler_t handler);
+
+//It is the user's responsibility to release the list returned
+BITPRIM_EXPORT
+stealth_compact_list_t stealth_index_get(stealth_index_t index, binary_t filter, uint64_t from_height);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_STEALTH_INDEX_H_ */
@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_STEALTH_INDEX_HPP_
+#define BITPRIM_NODECINT_STEALTH_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+
+#include <bitcoin/bitcoin/chain/stealth.hpp>
+#include <bitcoin/bitcoin/utility/binary.hpp>
+#include <bitcoin/blockchain/interface/safe_chain.hpp>
+
+namespace bitprim { namespace nodecint {
+
+// In-memory stealth rows bucketed by prefix, so that a query only visits the buckets its filter can match.
+// Filled by build (a parallel scan of the blocks) and kept up to date by a chain subscription.
+class stealth_index
+{
+public:
+    stealth_index(libbitcoin::blockchain::safe_chain& chain, size_t from_height);
+    ~stealth_index();
+
+    stealth_index(stealth_index const&) = delete;
+    void operator=(stealth_index const&) = delete;
+
+    std::error_code build(size_t threads);
+
+    size_t count() const;
+    size_t height() const;
+
+    // Sorted by prefix and then by height.
+    libbitcoin::chain::stealth_compact::list select(libbitcoin::binary const& filter, size_t from_height) const;
+
+private:
+    class store;
+
+    libbitcoin::blockchain::safe_chain& chain_;
+    size_t const from_height_;
+
+    // Shared with the chain subscription, which can outlive the index.
+    std::shared_ptr<store> store_;
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_STEALTH_INDEX_HPP_ */
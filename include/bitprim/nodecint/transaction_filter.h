@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_TRANSACTION_FILTER_H_
+#define BITPRIM_NODECINT_TRANSACTION_FILTER_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <bitprim/nodecint/visibility.h>
+#include <bitprim/nodecint/primitives.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Note: Watchlist of output scripts and spent outputs. A transaction matches when one of its outputs pays to
+//      a script of the filter or one of its inputs spends an output of the filter. The script hash is the
+//      SHA-256 of the serialized script (without the size prefix).
+BITPRIM_EXPORT
+transaction_filter_t transaction_filter_construct();
+
+BITPRIM_EXPORT
+void transaction_filter_destruct(transaction_filter_t filter);
+
+BITPRIM_EXPORT
+void transaction_filter_add_script_hash(transaction_filter_t filter, hash_t script_hash);
+
+BITPRIM_EXPORT
+void transaction_filter_add_script(transaction_filter_t filter, script_t script);
+
+//Note: P2PKH and P2SH addresses, added as their output script.
+BITPRIM_EXPORT
+void transaction_filter_add_address(transaction_filter_t filter, payment_address_t address);
+
+BITPRIM_EXPORT
+void transaction_filter_add_output_point(transaction_filter_t filter, hash_t hash, uint32_t index);
+
+BITPRIM_EXPORT
+uint64_t /*size_t*/ transaction_filter_count(transaction_filter_t filter);
+
+BITPRIM_EXPORT
+int /*bool*/ transaction_filter_matches(transaction_filter_t filter, transaction_t transaction);
+
+//Note: Unlike chain_subscribe_transaction, the handler is only called for the transactions matching the filter
+//      (and once with a null transaction when the subscription is stopped). The subscription takes the ownership
+//      of the filter, it must not be used nor destructed afterwards.
+//      The subscription ends when the handler returns 0 or after it is destructed.
+BITPRIM_EXPORT
+transaction_subscription_t chain_subscribe_transaction_filtered(executor_t exec, chain_t chain, void* ctx, transaction_filter_t filter, subscribe_transaction_handler_t handler);
+
+//Note: takes the ownership of the filter. The transactions notified after it returns are matched with the new
+//      filter, the ones being notified can still be matched with the previous one.
+BITPRIM_EXPORT
+void chain_transaction_subscription_replace_filter(transaction_subscription_t subscription, transaction_filter_t filter);
+
+//Note: waits for a notification in progress on another thread, the handler is not called after it returns.
+//      It can be called from the handler itself.
+BITPRIM_EXPORT
+void chain_transaction_subscription_destruct(transaction_subscription_t subscription);
+
+BITPRIM_EXPORT
+uint64_t chain_transaction_subscription_seen(transaction_subscription_t subscription);
+
+BITPRIM_EXPORT
+uint64_t chain_transaction_subscription_matched(transaction_subscription_t subscription);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* BITPRIM_NODECINT_TRANSACTION_FILTER_H_ */
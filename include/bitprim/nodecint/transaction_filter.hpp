@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_TRANSACTION_FILTER_HPP_
+#define BITPRIM_NODECINT_TRANSACTION_FILTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <system_error>
+
+#include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+#include <bitcoin/blockchain/interface/safe_chain.hpp>
+
+namespace bitprim { namespace nodecint {
+
+// Exact sets of script hashes and outpoints, with a bloom filter in front so that most of the
+// transactions are discarded without touching the sets.
+class transaction_filter
+{
+public:
+    transaction_filter();
+    ~transaction_filter();
+
+    transaction_filter(transaction_filter&&);
+    transaction_filter& operator=(transaction_filter&&);
+
+    static libbitcoin::hash_digest script_hash(libbitcoin::chain::script const& script);
+
+    void add_script_hash(libbitcoin::hash_digest const& hash);
+    void add_script(libbitcoin::chain::script const& script);
+    void add_address(libbitcoin::wallet::payment_address const& address);
+    void add_output_point(libbitcoin::chain::output_point const& point);
+
+    size_t count() const;
+
+    // Not thread safe while entries are being added, the subscriptions only see filters no longer modified.
+    bool matches(libbitcoin::chain::transaction const& tx) const;
+
+private:
+    class sets;
+    std::unique_ptr<sets> sets_;
+};
+
+class transaction_subscription
+{
+public:
+    using handler = std::function<bool(std::error_code const&, libbitcoin::transaction_const_ptr)>;
+
+    transaction_subscription(libbitcoin::blockchain::safe_chain& chain, transaction_filter filter, handler notify);
+    // Waits for the handler calls in progress on other threads, the handler is not called afterwards.
+    ~transaction_subscription();
+
+    transaction_subscription(transaction_subscription const&) = delete;
+    void operator=(transaction_subscription const&) = delete;
+
+    void replace_filter(transaction_filter filter);
+
+    uint64_t seen() const;
+    uint64_t matched() const;
+
+private:
+    class state;
+
+    // Shared with the chain subscription, which can outlive this object.
+    std::shared_ptr<state> state_;
+};
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_TRANSACTION_FILTER_HPP_ */
@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_UNSPENT_LIST_HPP_
+#define BITPRIM_NODECINT_UNSPENT_LIST_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <bitprim/nodecint/primitives.h>
+
+#include <bitcoin/bitcoin/chain/history.hpp>
+
+namespace bitprim { namespace nodecint {
+
+// The outputs of an address not spent by any row of its history, ordered by height.
+struct unspent_list {
+    std::vector<unspent_output_t> outputs;
+    uint64_t balance;
+};
+
+// Reconciles the output and spend rows of a complete (unlimited) address history.
+unspent_list make_unspent_list(libbitcoin::chain::history_compact::list const& history);
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_UNSPENT_LIST_HPP_ */
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITPRIM_NODECINT_WORKER_POOL_HPP_
+#define BITPRIM_NODECINT_WORKER_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bitprim { namespace nodecint {
+
+// Fixed number of threads running the blocking chain lookups of the async API.
+// The threads are started by the first post and joined by stop().
+class worker_pool
+{
+public:
+    using job = std::function<void()>;
+
+    // threads == 0 uses one thread per core.
+    explicit worker_pool(size_t threads);
+    ~worker_pool();
+
+    worker_pool(worker_pool const&) = delete;
+    void operator=(worker_pool const&) = delete;
+
+    // Returns false (the job is not queued) once the pool is stopped.
+    bool post(job work);
+
+    // The queued jobs still run, then the threads are joined.
+    void stop();
+
+    size_t size() const;
+
+private:
+    void run();
+
+    size_t const size_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<job> jobs_;
+    std::vector<std::thread> threads_;
+    bool stopped_ = false;
+};
+
+// The pool of the executor owning the chain, registered while the executor is alive.
+void register_worker_pool(void const* chain, std::shared_ptr<worker_pool> pool);
+void unregister_worker_pool(void const* chain);
+
+// Null if the chain has no registered pool.
+std::shared_ptr<worker_pool> find_worker_pool(void const* chain);
+
+// Runs work on the pool of the chain, or on the calling thread if there is none (or it is stopped).
+void post_or_run(void const* chain, worker_pool::job work);
+
+} // namespace nodecint
+} // namespace bitprim
+
+#endif /* BITPRIM_NODECINT_WORKER_POOL_HPP_ */
@@ -24,12 +24,16 @@ ExecutorResource.prototype.run_wait = function() {
     return resX
 };
 
-ExecutorResource.prototype.get_last_height = function() {
-    return bitprim_native.get_last_height(this.executor);
+ExecutorResource.prototype.get_last_height = function(callback) {
+    bitprim_native.get_last_height(this.executor, callback);
+};
+
+ExecutorResource.prototype.fetch_block_height = function(hash_hex, callback) {
+    bitprim_native.fetch_block_height(this.executor, hash_hex, callback);
 };
 
 ExecutorResource.prototype.validate_tx = function(tx_hex, callback) {
-    return bitprim_native.validate_tx(this.executor, tx_hex, callback);
+    bitprim_native.validate_tx(this.executor, tx_hex, callback);
 };
 
 ExecutorResource.prototype.close = function() {
@@ -1,6 +1,16 @@
 #include <node.h>
+#include <uv.h>
+
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <bitprim/nodecint/executor_c.h>
+#include <bitprim/nodecint/hex.h>
+#include <bitprim/nodecint/chain/chain.h>
+#include <bitprim/nodecint/chain/transaction.h>
 
 #include <inttypes.h>   //TODO: Remove, it is for the printf (printing pointer addresses)
 
@@ -17,6 +27,180 @@ using v8::Exception;
 using v8::Number;
 using v8::Persistent;
 using v8::Function;
+using v8::HandleScope;
+
+// ---------------------------------------------
+// Async plumbing
+//
+// Every async call allocates its own request (holding its JS callback), so any
+// number of calls can be in flight at once. The chain calls are issued from the
+// libuv thread pool (uv_queue_work), some of them read the database on the
+// calling thread and must not block the event loop. The threads issuing them
+// never touch V8: the handlers store the result in the request, enqueue it on the
+// executor dispatcher and signal a uv_async_t. libuv coalesces the signals, so a
+// burst of completions is delivered to JS in a single event loop turn.
+
+struct request;
+
+struct dispatcher {
+    executor_t exec;
+    uv_async_t async;
+    std::mutex mutex;
+    std::vector<request*> completed;
+    size_t in_flight;       // JS thread only, requests not delivered yet
+    size_t working;         // JS thread only, uv works not finished yet (a pool thread can still be in the chain call)
+    bool destructing;       // JS thread only, the executor is destructed when both counts reach zero
+};
+
+struct request {
+    // Created on the JS thread, the async handle keeps the loop alive while requests are in flight.
+    explicit request(dispatcher* disp)
+        : disp(disp)
+    {
+        if (disp->in_flight++ == 0) {
+            uv_ref(reinterpret_cast<uv_handle_t*>(&disp->async));
+        }
+    }
+
+    virtual ~request() {
+        callback.Reset();
+    }
+
+    // Runs on a libuv pool thread, the handler of the chain call has to call dispatcher_complete.
+    // The request can be delivered (and deleted) as soon as the chain call is made.
+    virtual void issue() = 0;
+
+    // Runs on the JS thread.
+    virtual void deliver(Isolate* isolate) = 0;
+
+    // An exception thrown by one callback is reported without skipping the rest of the batch.
+    void call(Isolate* isolate, unsigned int argc, Local<Value> argv[]) {
+        v8::TryCatch try_catch(isolate);
+        Local<Function>::New(isolate, callback)->Call(isolate->GetCurrentContext()->Global(), argc, argv);
+        if (try_catch.HasCaught()) {
+            node::FatalException(isolate, try_catch);
+        }
+    }
+
+    dispatcher* disp;
+    chain_t chain = nullptr;
+    Persistent<Function> callback;
+    int error = 0;
+};
+
+// Called from libbitcoin threads.
+void dispatcher_complete(request* req) {
+    auto* disp = req->disp;
+    {
+        std::lock_guard<std::mutex> lock(disp->mutex);
+        disp->completed.push_back(req);
+    }
+    uv_async_send(&disp->async);
+}
+
+//Note: the work is not part of the request, which can be delivered (and deleted) while the chain call
+//      has not returned yet.
+struct issue_work {
+    uv_work_t work;
+    request* req;
+    dispatcher* disp;
+};
+
+void dispatcher_closed(uv_handle_t* handle);
+
+// Called from the JS thread. The node is only destructed once no request is undelivered and no pool thread
+// is still inside a chain call.
+void dispatcher_check_idle(dispatcher* disp) {
+    if (disp->in_flight != 0 || disp->working != 0) {
+        return;
+    }
+
+    if (disp->destructing) {
+        executor_destruct(disp->exec);
+        uv_close(reinterpret_cast<uv_handle_t*>(&disp->async), dispatcher_closed);
+    }
+}
+
+void request_issue(uv_work_t* work) {
+    static_cast<issue_work*>(work->data)->req->issue();
+}
+
+// Called from the JS thread.
+void request_issued(uv_work_t* work, int /*status*/) {
+    auto* disp = static_cast<issue_work*>(work->data)->disp;
+    delete static_cast<issue_work*>(work->data);
+
+    --disp->working;
+    dispatcher_check_idle(disp);
+}
+
+// Called from the JS thread.
+void queue_request(request* req) {
+    auto* disp = req->disp;
+    req->chain = executor_get_chain(disp->exec);
+
+    auto* work = new issue_work;
+    work->work.data = work;
+    work->req = req;
+    work->disp = disp;
+
+    ++disp->working;
+    uv_queue_work(uv_default_loop(), &work->work, request_issue, request_issued);
+}
+
+void dispatcher_drain(uv_async_t* handle) {
+    auto* disp = static_cast<dispatcher*>(handle->data);
+
+    std::vector<request*> batch;
+    {
+        std::lock_guard<std::mutex> lock(disp->mutex);
+        batch.swap(disp->completed);
+    }
+
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    for (auto* req : batch) {
+        req->deliver(isolate);
+        delete req;
+    }
+
+    disp->in_flight -= batch.size();
+    if (disp->in_flight == 0) {
+        uv_unref(reinterpret_cast<uv_handle_t*>(&disp->async));
+        dispatcher_check_idle(disp);
+    }
+}
+
+void dispatcher_closed(uv_handle_t* handle) {
+    auto* disp = static_cast<dispatcher*>(handle->data);
+
+    // Completions that arrived after the last drain are dropped without calling JS.
+    for (auto* req : disp->completed) {
+        delete req;
+    }
+    delete disp;
+}
+
+dispatcher* get_dispatcher(Local<Value> const& arg) {
+    return static_cast<dispatcher*>(v8::External::Cast(*arg)->Value());
+}
+
+bool check_args(FunctionCallbackInfo<Value> const& args, int count) {
+    Isolate* isolate = args.GetIsolate();
+
+    if (args.Length() != count) {
+        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong number of arguments")));
+        return false;
+    }
+
+    if ( ! args[0]->IsExternal() || ! args[count - 1]->IsFunction()) {
+        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong arguments")));
+        return false;
+    }
+
+    return true;
+}
 
 //void Method(FunctionCallbackInfo<Value> const& args) {
 //    Isolate* isolate = args.GetIsolate();
@@ -72,7 +256,18 @@ void bitprim_executor_construct(FunctionCallbackInfo<Value> const& args) {
     executor_t exec = executor_construct_fd(*path, sout_fd, serr_fd);
 //    printf("bitprim_executor_construct - exec: 0x%" PRIXPTR "\n", (uintptr_t)exec);
 
-    Local<External> ext = External::New(isolate, exec);
+    auto* disp = new dispatcher;
+    disp->exec = exec;
+    disp->in_flight = 0;
+    disp->working = 0;
+    disp->destructing = false;
+    uv_async_init(uv_default_loop(), &disp->async, dispatcher_drain);
+    disp->async.data = disp;
+
+    // Only referenced while there are requests in flight.
+    uv_unref(reinterpret_cast<uv_handle_t*>(&disp->async));
+
+    Local<External> ext = External::New(isolate, disp);
 //    printf("xxxxx 4\n");
     args.GetReturnValue().Set(ext);
 //    printf("xxxxx 5\n");
@@ -93,9 +288,16 @@ void bitprim_executor_destruct(const FunctionCallbackInfo<Value>& args) {
         return;
     }
 
-    void* vptr = v8::External::Cast(*args[0])->Value();
-    executor_t exec = (executor_t)vptr;
-    executor_destruct(exec);
+    auto* disp = get_dispatcher(args[0]);
+
+    if (disp->destructing) {
+        return;
+    }
+
+    //Note: the requests in flight still use the chain, the executor is destructed when the last of them is
+    //      both delivered and out of its chain call
+    disp->destructing = true;
+    dispatcher_check_idle(disp);
 }
 
 
@@ -113,8 +315,7 @@ void bitprim_executor_stop(const FunctionCallbackInfo<Value>& args) {
         return;
     }
 
-    void* vptr = v8::External::Cast(*args[0])->Value();
-    executor_t exec = (executor_t)vptr;
+    executor_t exec = get_dispatcher(args[0])->exec;
     executor_stop(exec);
 }
 
@@ -133,8 +334,7 @@ void bitprim_executor_initchain(const FunctionCallbackInfo<Value>& args) {
         return;
     }
 
-    void* vptr = v8::External::Cast(*args[0])->Value();
-    executor_t exec = (executor_t)vptr;
+    executor_t exec = get_dispatcher(args[0])->exec;
     int res = executor_initchain(exec);
 
     Local<Number> num = Number::New(isolate, res);
@@ -177,8 +377,7 @@ void bitprim_executor_run_wait(const FunctionCallbackInfo<Value>& args) {
         return;
     }
 
-    void* vptr = v8::External::Cast(*args[0])->Value();
-    executor_t exec = (executor_t)vptr;
+    executor_t exec = get_dispatcher(args[0])->exec;
     int res = executor_run_wait(exec);
 
     Local<Number> num = Number::New(isolate, res);
@@ -188,123 +387,158 @@ void bitprim_executor_run_wait(const FunctionCallbackInfo<Value>& args) {
 
 // ---------------------------------------------
 
-void bitprim_get_last_height(const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
+void last_height_handler(chain_t chain, void* ctx, int error, uint64_t /*size_t*/ h);
 
-    // Check the number of arguments passed.
-    if (args.Length() != 1) {
-        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong number of arguments")));
-        return;
+struct last_height_request : request {
+    using request::request;
+
+    void issue() override {
+        chain_fetch_last_height(chain, this, last_height_handler);
     }
 
-    if (!args[0]->IsExternal()) {
-        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong arguments")));
-        return;
+    void deliver(Isolate* isolate) override {
+        unsigned int const argc = 2;
+        Local<Value> argv[argc] = { Number::New(isolate, error), Number::New(isolate, static_cast<double>(height)) };
+        call(isolate, argc, argv);
     }
 
-    void* vptr = v8::External::Cast(*args[0])->Value();
-    executor_t exec = (executor_t)vptr;
-    size_t height;
-    int res = get_last_height(exec, &height);
+    uint64_t height = 0;
+};
 
-    Local<Number> num = Number::New(isolate, height);
-    args.GetReturnValue().Set(num);
+void last_height_handler(chain_t /*chain*/, void* ctx, int error, uint64_t /*size_t*/ h) {
+    auto* req = static_cast<last_height_request*>(ctx);
+    req->error = error;
+    req->height = h;
+    dispatcher_complete(req);
 }
-// ---------------------------------------------
-
-Persistent<Function> callback;
 
-//void validate_tx(executor_t exec, transaction_t tx, run_handler_t handler) {
+// get_last_height(exec, callback(err, height))
+void bitprim_get_last_height(FunctionCallbackInfo<Value> const& args) {
+    if ( ! check_args(args, 2)) {
+        return;
+    }
 
-void validate_tx_callback(int error, char* message) {
-    Isolate* isolate = Isolate::GetCurrent();
+    auto* disp = get_dispatcher(args[0]);
+    auto* req = new last_height_request(disp);
+    req->callback.Reset(args.GetIsolate(), args[1].As<Function>());
+    queue_request(req);
+}
 
-    // printf("validate_tx_callback - 1\n");
+// ---------------------------------------------
 
-    // printf("validate_tx_callback - error:   %d\n", error);
-    // printf("validate_tx_callback - message: %s\n", message);
+void block_height_handler(chain_t chain, void* ctx, int error, uint64_t /*size_t*/ h);
 
-//    unsigned int const argc = 2;
-////    Local<Value> argv[argc] = { Null(isolate), String::NewFromUtf8(isolate, "success") };
-//    Local<Value> argv[argc] = { Null(isolate), Number::New(isolate, error) };
+struct block_height_request : request {
+    using request::request;
 
-    unsigned int const argc = 2;
-    if (message == nullptr) {
-        message = "";
+    void issue() override {
+        chain_fetch_block_height(chain, this, hash, block_height_handler);
     }
-    Local<Value> argv[argc] = { Number::New(isolate, error), String::NewFromUtf8(isolate, message) };
 
+    void deliver(Isolate* isolate) override {
+        unsigned int const argc = 2;
+        Local<Value> argv[argc] = { Number::New(isolate, error), Number::New(isolate, static_cast<double>(height)) };
+        call(isolate, argc, argv);
+    }
 
+    hash_t hash;
+    uint64_t height = 0;
+};
 
-    // printf("validate_tx_callback - 2n");
-
-    Local<Function>::New(isolate, callback)->Call(isolate->GetCurrentContext()->Global(), argc, argv);
-
-    // printf("validate_tx_callback - 3\n");
-
-    callback.Reset();
-
-    // printf("validate_tx_callback - 4\n");
+void block_height_handler(chain_t /*chain*/, void* ctx, int error, uint64_t /*size_t*/ h) {
+    auto* req = static_cast<block_height_request*>(ctx);
+    req->error = error;
+    req->height = h;
+    dispatcher_complete(req);
 }
 
-void bitprim_validate_tx(FunctionCallbackInfo<Value> const& args) {
+// fetch_block_height(exec, block_hash_hex, callback(err, height))
+void bitprim_fetch_block_height(FunctionCallbackInfo<Value> const& args) {
     Isolate* isolate = args.GetIsolate();
 
-    // printf("bitprim_validate_tx - 1\n");
-    if (args.Length() != 3) {
-        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong number of arguments")));
-        return;
-    }
-
-    // printf("bitprim_validate_tx - 2\n");
-
-    if ( ! args[0]->IsExternal()) {
-        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong arguments")));
+    if ( ! check_args(args, 3)) {
         return;
     }
 
-    // printf("bitprim_validate_tx - 3\n");
-
     if ( ! args[1]->IsString()) {
         isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong arguments")));
         return;
     }
 
-    // printf("bitprim_validate_tx - 4\n");
+    v8::String::Utf8Value hash_hex(args[1]->ToString());
+    hash_t hash;
 
-    if ( ! args[2]->IsFunction()) {
-        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong arguments")));
+    if ( ! hex_to_hash(*hash_hex, &hash)) {
+        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Invalid block hash")));
         return;
     }
 
-    // printf("bitprim_validate_tx - 5\n");
-
-    void* vptr = v8::External::Cast(*args[0])->Value();
-    executor_t exec = (executor_t)vptr;
+    auto* disp = get_dispatcher(args[0]);
+    auto* req = new block_height_request(disp);
+    req->callback.Reset(isolate, args[2].As<Function>());
+    req->hash = hash;
+    queue_request(req);
+}
 
-    // printf("bitprim_validate_tx - 6\n");
+// ---------------------------------------------
 
+void validate_tx_handler(chain_t chain, void* ctx, int error, char const* message);
 
-    v8::String::Utf8Value tx_hex(args[1]->ToString());
+struct validate_tx_request : request {
+    using request::request;
 
-    // printf("bitprim_validate_tx - 7\n");
+    // The chain keeps its own copy of the transaction.
+    void issue() override {
+        auto const copy = tx;
+        chain_validate_tx(chain, this, copy, validate_tx_handler);
+        chain_transaction_destruct(copy);
+    }
 
+    void deliver(Isolate* isolate) override {
+        unsigned int const argc = 2;
+        Local<Value> argv[argc] = { Number::New(isolate, error), String::NewFromUtf8(isolate, message.c_str()) };
+        call(isolate, argc, argv);
+    }
 
-    callback.Reset(isolate, args[2].As<Function>());
+    transaction_t tx = nullptr;
+    std::string message;
+};
 
-    // printf("bitprim_validate_tx - 8\n");
+void validate_tx_handler(chain_t /*chain*/, void* ctx, int error, char const* message) {
+    auto* req = static_cast<validate_tx_request*>(ctx);
+    req->error = error;
+    if (message != nullptr) {
+        req->message = message;
+    }
+    dispatcher_complete(req);
+}
 
-    auto tx = hex_to_tx(*tx_hex);
+// validate_tx(exec, tx_hex, callback(err, message))
+void bitprim_validate_tx(FunctionCallbackInfo<Value> const& args) {
+    Isolate* isolate = args.GetIsolate();
 
-    // printf("bitprim_validate_tx - 9\n");
+    if ( ! check_args(args, 3)) {
+        return;
+    }
 
-    // printf("tx: %p\n", tx);
+    if ( ! args[1]->IsString()) {
+        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Wrong arguments")));
+        return;
+    }
 
-    validate_tx(exec, tx, validate_tx_callback);
+    v8::String::Utf8Value tx_hex(args[1]->ToString());
 
-    // printf("bitprim_validate_tx - 10\n");
+    auto tx = hex_to_tx(*tx_hex);
+    if (tx == nullptr) {
+        isolate->ThrowException(Exception::TypeError(String::NewFromUtf8(isolate, "Invalid transaction")));
+        return;
+    }
 
-    //TODO: free tx
+    auto* disp = get_dispatcher(args[0]);
+    auto* req = new validate_tx_request(disp);
+    req->callback.Reset(isolate, args[2].As<Function>());
+    req->tx = tx;
+    queue_request(req);
 }
 
 
@@ -355,6 +589,7 @@ void init(Local<Object> exports) {
     NODE_SET_METHOD(exports, "run_wait", bitprim_executor_run_wait);
     NODE_SET_METHOD(exports, "validate_tx", bitprim_validate_tx);
     NODE_SET_METHOD(exports, "get_last_height", bitprim_get_last_height);
+    NODE_SET_METHOD(exports, "fetch_block_height", bitprim_fetch_block_height);
 }
 
 NODE_MODULE(bitprim, init)
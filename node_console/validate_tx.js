@@ -37,22 +37,39 @@ process.on("exit", function () {
 // ---------------------------------
 
 app.get('/last-height', function(request, response) {
-    var txhex = request.params.txhex;
+    exec.get_last_height(function (err, height) {
+        response.send(`last-height: ${height}`)
+    })
+})
 
-    var height = exec.get_last_height()
-    response.send(`last-height: ${height}`)
+app.get('/block-height/:hash', function(request, response) {
+    try {
+        exec.fetch_block_height(request.params.hash, function (err, height) {
+            if (err == 0) {
+                response.send(`block-height: ${height}`)
+            } else {
+                response.send(`Block not found, err: ${err}`)
+            }
+        })
+    } catch (e) {
+        response.status(400).send(e.message)
+    }
 })
 
 app.get('/validate-tx/:txhex', function(request, response) {
     var txhex = request.params.txhex;
 
-    exec.validate_tx(txhex, function (err, message) {
-        if (err == 0) {
-            response.send(`Transaction is valid!`)
-        } else {
-            response.send(`Transaction is invalid, err: ${err}, message: ${message}`)
-        }
-    })
+    try {
+        exec.validate_tx(txhex, function (err, message) {
+            if (err == 0) {
+                response.send(`Transaction is valid!`)
+            } else {
+                response.send(`Transaction is invalid, err: ${err}, message: ${message}`)
+            }
+        })
+    } catch (e) {
+        response.status(400).send(e.message)
+    }
 })
 
 app.listen(8080, (err) => {
@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/api_stats.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace bitprim { namespace nodecint {
+
+namespace {
+
+inline
+size_t highest_bit(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long res;
+    _BitScanReverse64(&res, value);
+    return res;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+void update_max(std::atomic<uint64_t>& max, uint64_t value) {
+    auto current = max.load(std::memory_order_relaxed);
+    while (value > current && ! max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+struct registry {
+    std::mutex mutex;
+    std::deque<api_entry> entries;      // stable addresses
+    std::unordered_map<std::string, api_entry*> by_name;
+};
+
+registry& api_registry() {
+    static registry instance;
+    return instance;
+}
+
+} /* end of anonymous namespace */
+
+// api_histogram
+// ----------------------------------------------------------------------------
+
+constexpr size_t api_histogram::sub_bits;
+constexpr size_t api_histogram::sub_count;
+constexpr size_t api_histogram::max_exponent;
+constexpr size_t api_histogram::bucket_count;
+
+api_histogram::api_histogram()
+    : count_(0), sum_(0), max_(0)
+{
+    for (auto& x : buckets_) {
+        x.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Values below sub_count have their own bucket, the others share it with the values of the same
+// highest bit and the same next sub_bits bits.
+size_t api_histogram::bucket(uint64_t value) {
+    if (value < sub_count) {
+        return value;
+    }
+
+    auto const exponent = highest_bit(value);
+    if (exponent > max_exponent) {
+        return bucket_count - 1;
+    }
+
+    auto const sub = (value >> (exponent - sub_bits)) & (sub_count - 1);
+    return (exponent - sub_bits + 1) * sub_count + sub;
+}
+
+uint64_t api_histogram::bucket_upper_bound(size_t index) {
+    if (index < sub_count) {
+        return index;
+    }
+
+    auto const exponent = index / sub_count + sub_bits - 1;
+    auto const sub = index % sub_count;
+    auto const width = uint64_t(1) << (exponent - sub_bits);
+    return ((sub_count + sub) << (exponent - sub_bits)) + width - 1;
+}
+
+void api_histogram::record(uint64_t value) {
+    buckets_[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    update_max(max_, value);
+}
+
+uint64_t api_histogram::count() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+uint64_t api_histogram::sum() const {
+    return sum_.load(std::memory_order_relaxed);
+}
+
+uint64_t api_histogram::max() const {
+    return max_.load(std::memory_order_relaxed);
+}
+
+// The buckets are read one by one while they can be updated, the result is approximate under load.
+uint64_t api_histogram::quantile(double q) const {
+    uint64_t total = 0;
+    for (auto const& x : buckets_) {
+        total += x.load(std::memory_order_relaxed);
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    auto const rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * total + 0.5));
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < bucket_count; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucket_upper_bound(i), max());
+        }
+    }
+
+    return max();
+}
+
+// api_entry
+// ----------------------------------------------------------------------------
+
+api_entry::api_entry(std::string name)
+    : name_(std::move(name))
+{}
+
+std::string const& api_entry::name() const {
+    return name_;
+}
+
+void api_entry::record_latency(uint64_t nanoseconds) {
+    latency_.record(nanoseconds);
+}
+
+void api_entry::record_blocked(uint64_t nanoseconds) {
+    blocked_.record(nanoseconds);
+}
+
+api_histogram const& api_entry::latency() const {
+    return latency_;
+}
+
+api_histogram const& api_entry::blocked() const {
+    return blocked_;
+}
+
+api_stats_t api_entry::stats() const {
+    api_stats_t res;
+    res.name = name_.c_str();
+    res.calls = latency_.count();
+    res.latency_sum = latency_.sum();
+    res.latency_max = latency_.max();
+    res.latency_p50 = latency_.quantile(0.5);
+    res.latency_p90 = latency_.quantile(0.9);
+    res.latency_p99 = latency_.quantile(0.99);
+    res.latency_p999 = latency_.quantile(0.999);
+    res.blocked_calls = blocked_.count();
+    res.blocked_sum = blocked_.sum();
+    res.blocked_max = blocked_.max();
+    res.blocked_p99 = blocked_.quantile(0.99);
+    return res;
+}
+
+// registry
+// ----------------------------------------------------------------------------
+
+api_entry& api_stats_entry(char const* name) {
+    auto& reg = api_registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    auto const found = reg.by_name.find(name);
+    if (found != reg.by_name.end()) {
+        return *found->second;
+    }
+
+    reg.entries.emplace_back(name);
+    reg.by_name.emplace(name, &reg.entries.back());
+    return reg.entries.back();
+}
+
+std::vector<api_entry const*> api_stats_entries() {
+    auto& reg = api_registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::vector<api_entry const*> res;
+    res.reserve(reg.entries.size());
+    for (auto const& x : reg.entries) {
+        res.push_back(&x);
+    }
+    return res;
+}
+
+std::string api_stats_prometheus() {
+    static double const quantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+    std::ostringstream out;
+    out << "# HELP nodecint_api_latency_seconds Time from the call to the callback of the C API functions.\n"
+        << "# TYPE nodecint_api_latency_seconds summary\n";
+
+    auto const entries = api_stats_entries();
+
+    for (auto const* entry : entries) {
+        auto const& latency = entry->latency();
+        for (auto q : quantiles) {
+            out << "nodecint_api_latency_seconds{function=\"" << entry->name() << "\",quantile=\"" << q << "\"} " << latency.quantile(q) * 1e-9 << '\n';
+        }
+        out << "nodecint_api_latency_seconds_sum{function=\"" << entry->name() << "\"} " << latency.sum() * 1e-9 << '\n'
+            << "nodecint_api_latency_seconds_count{function=\"" << entry->name() << "\"} " << latency.count() << '\n';
+    }
+
+    out << "# HELP nodecint_api_blocked_seconds Time the synchronous C API functions wait for the result.\n"
+        << "# TYPE nodecint_api_blocked_seconds summary\n";
+
+    for (auto const* entry : entries) {
+        auto const& blocked = entry->blocked();
+        if (blocked.count() == 0) {
+            continue;
+        }
+
+        for (auto q : quantiles) {
+            out << "nodecint_api_blocked_seconds{function=\"" << entry->name() << "\",quantile=\"" << q << "\"} " << blocked.quantile(q) * 1e-9 << '\n';
+        }
+        out << "nodecint_api_blocked_seconds_sum{function=\"" << entry->name() << "\"} " << blocked.sum() * 1e-9 << '\n'
+            << "nodecint_api_blocked_seconds_count{function=\"" << entry->name() << "\"} " << blocked.count() << '\n';
+    }
+
+    return out.str();
+}
+
+} // namespace nodecint
+} // namespace bitprim
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/arena.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace bitprim { namespace nodecint {
+
+arena::arena(size_t block_size)
+    : block_size_(std::max(block_size, size_t(1024)))
+{}
+
+arena::~arena() {
+    release_objects();
+
+    for (auto const& x : blocks_) {
+        delete [] x.data;
+    }
+}
+
+char const* arena::copy(std::string const& str) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto* res = static_cast<char*>(allocate(str.size() + 1, 1));
+    std::memcpy(res, str.c_str(), str.size() + 1);
+    return res;
+}
+
+void arena::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    release_objects();
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+size_t arena::object_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return objects_;
+}
+
+size_t arena::bytes_used() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_ + offset_;
+}
+
+size_t arena::bytes_reserved() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    size_t res = 0;
+    for (auto const& x : blocks_) {
+        res += x.size;
+    }
+    return res;
+}
+
+// Called with the mutex locked.
+// Blocks are kept after a reset and filled again in the same order, an allocation
+// that does not fit moves to the next block (a new one if needed, sized to fit).
+void* arena::allocate(size_t size, size_t alignment) {
+    while (current_ < blocks_.size()) {
+        auto const& x = blocks_[current_];
+
+        //Note: the address is aligned, not the offset, for types aligned beyond what operator new[] gives
+        auto const base = reinterpret_cast<uintptr_t>(x.data);
+        auto const aligned = ((base + offset_ + alignment - 1) & ~uintptr_t(alignment - 1)) - base;
+
+        if (aligned + size <= x.size) {
+            offset_ = aligned + size;
+            return x.data + aligned;
+        }
+
+        used_ += offset_;
+        ++current_;
+        offset_ = 0;
+    }
+
+    // Room to align the first object whatever the alignment of the block.
+    auto const new_size = std::max(block_size_, size + alignment - 1);
+    blocks_.push_back(block{new char[new_size], new_size});
+    return allocate(size, alignment);
+}
+
+// Called with the mutex locked, in reverse order of construction.
+void arena::release_objects() {
+    while (destructors_ != nullptr) {
+        auto* node = destructors_;
+        destructors_ = node->next;
+        node->destroy(node->object);
+    }
+    objects_ = 0;
+}
+
+} // namespace nodecint
+} // namespace bitprim
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/arena.h>
+
+#include <bitprim/nodecint/arena.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::arena& arena_cpp(nodecint_arena_t arena) {
+    return *static_cast<bitprim::nodecint::arena*>(arena);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+nodecint_arena_t nodecint_arena_construct(uint64_t /*size_t*/ block_size) {
+    return new bitprim::nodecint::arena(block_size);
+}
+
+void nodecint_arena_destruct(nodecint_arena_t arena) {
+    delete &arena_cpp(arena);
+}
+
+void nodecint_arena_reset(nodecint_arena_t arena) {
+    arena_cpp(arena).reset();
+}
+
+uint64_t /*size_t*/ nodecint_arena_object_count(nodecint_arena_t arena) {
+    return arena_cpp(arena).object_count();
+}
+
+uint64_t /*size_t*/ nodecint_arena_bytes_used(nodecint_arena_t arena) {
+    return arena_cpp(arena).bytes_used();
+}
+
+uint64_t /*size_t*/ nodecint_arena_bytes_reserved(nodecint_arena_t arena) {
+    return arena_cpp(arena).bytes_reserved();
+}
+
+} /* extern "C" */
@@ -64,6 +64,10 @@ char* binary_encoded(binary_t binary) {
     return ret;
 }
 
+void binary_destruct(binary_t binary) {
+    delete &binary_cpp(binary);
+}
+
 /*
 binary::binary(const binary& other)
   : blocks_(other.blocks_), final_block_excess_(other.final_block_excess_)
@@ -0,0 +1,500 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/block_template.hpp>
+#include <bitprim/nodecint/sha256.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/message/header.hpp>
+#include <bitcoin/bitcoin/message/version.hpp>
+
+namespace bitprim { namespace nodecint {
+
+namespace {
+
+using libbitcoin::hash_digest;
+
+// Room left for the block header and the coinbase.
+constexpr size_t coinbase_reserve = 1000;
+
+struct hash_hasher {
+    size_t operator()(hash_digest const& hash) const {
+        // The bytes are already uniformly distributed.
+        size_t res;
+        std::memcpy(&res, hash.data(), sizeof(res));
+        return res;
+    }
+};
+
+using clock = std::chrono::steady_clock;
+
+uint64_t microseconds_since(clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+}
+
+hash_digest merkle_parent(hash_digest const& left, hash_digest const& right) {
+    hash_digest pair[2] = {left, right};
+    hash_digest res;
+    bitprim::sha256::double_hash64(pair[0].data(), 1, res.data());
+    return res;
+}
+
+// Merkle tree of a block with the coinbase (leaf 0) unknown, only the coinbase branch is needed.
+// The nodes on the coinbase path are never computed, appending a leaf updates the right edge only.
+class coinbase_tree {
+public:
+    coinbase_tree() {
+        clear();
+    }
+
+    void clear() {
+        levels_.assign(1, {hash_digest{}});
+    }
+
+    void append(hash_digest const& leaf) {
+        levels_[0].push_back(leaf);
+
+        for (size_t k = 0; levels_[k].size() > 1; ++k) {
+            if (levels_.size() == k + 1) {
+                levels_.emplace_back();
+            }
+
+            auto const& level = levels_[k];
+            auto& upper = levels_[k + 1];
+            auto const parent = (level.size() - 1) / 2;
+
+            upper.resize(parent + 1);
+            if (parent != 0) {
+                upper[parent] = node(level, parent);
+            }
+        }
+    }
+
+    void assign(std::vector<hash_digest> const& leaves) {
+        clear();
+        levels_[0].insert(levels_[0].end(), leaves.begin(), leaves.end());
+
+        for (size_t k = 0; levels_[k].size() > 1; ++k) {
+            levels_.emplace_back((levels_[k].size() + 1) / 2);
+
+            auto const& level = levels_[k];
+            auto& upper = levels_[k + 1];
+            for (size_t parent = 1; parent < upper.size(); ++parent) {
+                upper[parent] = node(level, parent);
+            }
+        }
+    }
+
+    libbitcoin::hash_list branch() const {
+        libbitcoin::hash_list res;
+        for (size_t k = 0; k < levels_.size() && levels_[k].size() > 1; ++k) {
+            res.push_back(levels_[k][1]);
+        }
+        return res;
+    }
+
+private:
+    // The last node of an odd level is paired with itself.
+    static
+    hash_digest node(std::vector<hash_digest> const& level, size_t parent) {
+        auto const& left = level[2 * parent];
+        auto const& right = 2 * parent + 1 < level.size() ? level[2 * parent + 1] : left;
+        return merkle_parent(left, right);
+    }
+
+    std::vector<std::vector<hash_digest>> levels_;
+};
+
+// The fee needs the previous outputs cached by the validation. The transactions of a block popped off the
+// store do not have them, those get no fee (the lowest rate) rather than a wrong one.
+uint64_t known_fee(libbitcoin::chain::transaction const& tx) {
+    for (auto const& input : tx.inputs()) {
+        if ( ! input.previous_output().validation.cache.is_valid()) {
+            return 0;
+        }
+    }
+    return tx.fees();
+}
+
+} /* end of anonymous namespace */
+
+// block_template::store
+// ----------------------------------------------------------------------------
+
+class block_template::store
+{
+public:
+    store(size_t max_block_size, size_t max_pool_count)
+        : max_size_(max_block_size > coinbase_reserve ? max_block_size - coinbase_reserve : 0)
+        , max_pool_count_(max_pool_count)
+    {}
+
+    void set_tip(size_t height, hash_digest const& hash) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        height_ = height + 1;
+        previous_hash_ = hash;
+        snapshot_.reset();
+    }
+
+    void add(libbitcoin::transaction_const_ptr const& tx) {
+        auto const hash = tx->hash();
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto* entry = insert(hash, tx);
+        if (entry == nullptr) {
+            return;
+        }
+
+        if (trim()) {
+            // A selected transaction was evicted.
+            full_build();
+            return;
+        }
+
+        // The new transaction itself may have been evicted.
+        if (pool_.count(hash) == 0 || ! selectable(*entry)) {
+            return;
+        }
+
+        auto const start = clock::now();
+        select(hash, *entry);
+        tree_.append(hash);
+        snapshot_.reset();
+        ++revision_;
+
+        last_incremental_us_ = microseconds_since(start);
+        max_incremental_us_ = std::max(max_incremental_us_, last_incremental_us_);
+        ++incremental_updates_;
+    }
+
+    // The non-coinbase transactions of the replaced blocks go back to the pool, unless the incoming blocks mine them
+    // again. Then the transactions of the incoming blocks and the ones spending the same outputs leave the pool,
+    // and the template is rebuilt.
+    void organize(size_t fork_height, libbitcoin::block_const_ptr_list const& incoming, libbitcoin::block_const_ptr_list const& replaced) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if ( ! replaced.empty()) {
+            std::unordered_set<hash_digest, hash_hasher> mined;
+            for (auto const& block : incoming) {
+                for (auto const& tx : block->transactions()) {
+                    mined.insert(tx.hash());
+                }
+            }
+
+            for (auto const& block : replaced) {
+                for (auto const& tx : block->transactions()) {
+                    auto const hash = tx.hash();
+                    if ( ! tx.is_coinbase() && mined.count(hash) == 0) {
+                        insert(hash, std::make_shared<libbitcoin::message::transaction const>(tx));
+                    }
+                }
+            }
+        }
+
+        for (auto const& block : incoming) {
+            for (auto const& tx : block->transactions()) {
+                remove(tx.hash());
+
+                for (auto const& input : tx.inputs()) {
+                    auto const spender = spenders_.find(input.previous_output().checksum());
+                    if (spender != spenders_.end()) {
+                        remove(hash_digest(spender->second));
+                    }
+                }
+            }
+        }
+
+        if ( ! incoming.empty()) {
+            height_ = fork_height + incoming.size() + 1;
+            previous_hash_ = incoming.back()->hash();
+        }
+
+        trim();
+        full_build();
+    }
+
+    snapshot_ptr snapshot() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if ( ! snapshot_) {
+            auto res = std::make_shared<block_template_snapshot>();
+            res->revision = revision_;
+            res->height = height_;
+            res->previous_hash = previous_hash_;
+            res->fees = fees_;
+            res->serialized_size = size_;
+            res->hashes = selected_;
+            res->merkle_branch = tree_.branch();
+
+            res->transactions.reserve(selected_.size());
+            for (auto const& hash : selected_) {
+                res->transactions.push_back(pool_[hash].tx);
+            }
+
+            snapshot_ = std::move(res);
+        }
+
+        return snapshot_;
+    }
+
+    block_template_stats_t stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        block_template_stats_t res;
+        res.full_builds = full_builds_;
+        res.incremental_updates = incremental_updates_;
+        res.last_full_build_us = last_full_build_us_;
+        res.max_full_build_us = max_full_build_us_;
+        res.last_incremental_us = last_incremental_us_;
+        res.max_incremental_us = max_incremental_us_;
+        res.pool_size = pool_.size();
+        res.selected = selected_.size();
+        res.evicted = evicted_;
+        return res;
+    }
+
+private:
+    struct pool_entry {
+        libbitcoin::transaction_const_ptr tx;
+        hash_digest hash;
+        size_t size;
+        uint64_t fee;
+        uint64_t sequence;
+        bool selected = false;
+    };
+
+    // Highest fee rate first, the oldest first for the same rate.
+    struct by_fee_rate {
+        bool operator()(pool_entry const* a, pool_entry const* b) const {
+            // a.fee / a.size > b.fee / b.size
+            auto const left = double(a->fee) * b->size;
+            auto const right = double(b->fee) * a->size;
+            if (left != right) {
+                return left > right;
+            }
+            return a->sequence < b->sequence;
+        }
+    };
+
+    // Called with the mutex locked.
+    // Returns nullptr when the transaction is already in the pool.
+    pool_entry* insert(hash_digest const& hash, libbitcoin::transaction_const_ptr tx) {
+        if (pool_.count(hash) != 0) {
+            return nullptr;
+        }
+
+        auto& entry = pool_[hash];
+        entry.hash = hash;
+        entry.size = tx->serialized_size(libbitcoin::message::version::level::canonical);
+        entry.fee = known_fee(*tx);
+        entry.sequence = ++sequence_;
+        entry.tx = std::move(tx);
+
+        for (auto const& input : entry.tx->inputs()) {
+            spenders_[input.previous_output().checksum()] = hash;
+        }
+
+        by_rate_.insert(&entry);
+        return &entry;
+    }
+
+    // Called with the mutex locked.
+    // Evicts the lowest fee rates while the pool is over its cap, returns whether a selected transaction was evicted.
+    bool trim() {
+        auto selected = false;
+        while (max_pool_count_ != 0 && pool_.size() > max_pool_count_) {
+            auto const* lowest = *by_rate_.rbegin();
+            selected = selected || lowest->selected;
+            remove(hash_digest(lowest->hash));
+            ++evicted_;
+        }
+        return selected;
+    }
+
+    // Called with the mutex locked.
+    void full_build() {
+        auto const start = clock::now();
+        rebuild();
+
+        last_full_build_us_ = microseconds_since(start);
+        max_full_build_us_ = std::max(max_full_build_us_, last_full_build_us_);
+        ++full_builds_;
+    }
+
+    // Called with the mutex locked.
+    // Parents still in the pool must come first in the block.
+    bool selectable(pool_entry const& entry) const {
+        if (entry.selected || size_ + entry.size > max_size_) {
+            return false;
+        }
+
+        for (auto const& input : entry.tx->inputs()) {
+            auto const parent = pool_.find(input.previous_output().hash());
+            if (parent != pool_.end() && ! parent->second.selected) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Called with the mutex locked.
+    void select(hash_digest const& hash, pool_entry& entry) {
+        entry.selected = true;
+        selected_.push_back(hash);
+        size_ += entry.size;
+        fees_ += entry.fee;
+    }
+
+    // Called with the mutex locked.
+    void remove(hash_digest const& hash) {
+        auto const it = pool_.find(hash);
+        if (it == pool_.end()) {
+            return;
+        }
+
+        for (auto const& input : it->second.tx->inputs()) {
+            auto const spender = spenders_.find(input.previous_output().checksum());
+            if (spender != spenders_.end() && spender->second == hash) {
+                spenders_.erase(spender);
+            }
+        }
+
+        by_rate_.erase(&it->second);
+        pool_.erase(it);
+    }
+
+    // Called with the mutex locked.
+    // Highest fee rate first. A transaction whose parents come later is retried once after the first pass.
+    void rebuild() {
+        for (auto& x : pool_) {
+            x.second.selected = false;
+        }
+
+        selected_.clear();
+        size_ = 0;
+        fees_ = 0;
+
+        for (size_t pass = 0; pass < 2; ++pass) {
+            for (auto* entry : by_rate_) {
+                if (selectable(*entry)) {
+                    select(entry->hash, *entry);
+                }
+            }
+        }
+
+        tree_.assign(selected_);
+        snapshot_.reset();
+        ++revision_;
+    }
+
+    mutable std::mutex mutex_;
+    size_t const max_size_;
+    size_t const max_pool_count_;
+
+    std::unordered_map<hash_digest, pool_entry, hash_hasher> pool_;
+    std::unordered_map<uint64_t, hash_digest> spenders_;     // output checksum -> pool transaction
+    std::set<pool_entry*, by_fee_rate> by_rate_;
+    uint64_t sequence_ = 0;
+
+    size_t height_ = 0;
+    hash_digest previous_hash_ = libbitcoin::null_hash;
+    std::vector<hash_digest> selected_;
+    coinbase_tree tree_;
+    size_t size_ = 0;
+    uint64_t fees_ = 0;
+    uint64_t revision_ = 0;
+    snapshot_ptr snapshot_;
+
+    uint64_t full_builds_ = 0;
+    uint64_t incremental_updates_ = 0;
+    uint64_t last_full_build_us_ = 0;
+    uint64_t max_full_build_us_ = 0;
+    uint64_t last_incremental_us_ = 0;
+    uint64_t max_incremental_us_ = 0;
+    uint64_t evicted_ = 0;
+};
+
+// block_template
+// ----------------------------------------------------------------------------
+
+block_template::block_template(libbitcoin::blockchain::safe_chain& chain, size_t max_block_size, size_t max_pool_count)
+    : store_(std::make_shared<store>(max_block_size, max_pool_count))
+{
+    auto template_store = store_;
+
+    chain.fetch_last_height([&chain, template_store](std::error_code const& ec, size_t height) {
+        if (ec) {
+            return;
+        }
+
+        chain.fetch_block_header(height, [template_store, height](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t /*h*/) {
+            if ( ! ec && header) {
+                template_store->set_tip(height, header->hash());
+            }
+        });
+    });
+
+    std::weak_ptr<store> weak_store = store_;
+
+    // The subscriptions end on the first notification after the template is destructed.
+    chain.subscribe_transaction([weak_store](std::error_code const& ec, libbitcoin::transaction_const_ptr tx) {
+        auto const template_store = weak_store.lock();
+        if (ec || ! template_store) {
+            return false;
+        }
+
+        // The accepted transactions keep their previous outputs from validation, needed for the fee.
+        template_store->add(tx);
+        return true;
+    });
+
+    chain.subscribe_blockchain([weak_store](std::error_code const& ec, size_t fork_height, libbitcoin::block_const_ptr_list_const_ptr incoming, libbitcoin::block_const_ptr_list_const_ptr replaced_blocks) {
+        auto const template_store = weak_store.lock();
+        if (ec || ! template_store) {
+            return false;
+        }
+
+        static libbitcoin::block_const_ptr_list const none;
+        template_store->organize(fork_height, incoming ? *incoming : none, replaced_blocks ? *replaced_blocks : none);
+        return true;
+    });
+}
+
+block_template::~block_template() = default;
+
+block_template::snapshot_ptr block_template::snapshot() const {
+    return store_->snapshot();
+}
+
+block_template_stats_t block_template::stats() const {
+    return store_->stats();
+}
+
+} // namespace nodecint
+} // namespace bitprim
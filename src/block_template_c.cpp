@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/block_template.h>
+
+#include <bitprim/nodecint/block_template.hpp>
+#include <bitprim/nodecint/convertions.hpp>
+#include <bitprim/nodecint/helpers.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::block_template& block_template_cpp(block_template_t tmpl) {
+    return *static_cast<bitprim::nodecint::block_template*>(tmpl);
+}
+
+inline
+bitprim::nodecint::block_template_snapshot const& snapshot_const_cpp(block_template_snapshot_t snapshot) {
+    return **static_cast<bitprim::nodecint::block_template::snapshot_ptr const*>(snapshot);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+block_template_t block_template_construct(chain_t chain, uint64_t /*size_t*/ max_block_size, uint64_t /*size_t*/ max_pool_count) {
+    return new bitprim::nodecint::block_template(*static_cast<libbitcoin::blockchain::safe_chain*>(chain), max_block_size, max_pool_count);
+}
+
+void block_template_destruct(block_template_t tmpl) {
+    delete &block_template_cpp(tmpl);
+}
+
+//It is the user's responsibility to release the snapshot returned
+block_template_snapshot_t block_template_snapshot(block_template_t tmpl) {
+    return new bitprim::nodecint::block_template::snapshot_ptr(block_template_cpp(tmpl).snapshot());
+}
+
+void block_template_stats(block_template_t tmpl, block_template_stats_t* out_stats) {
+    *out_stats = block_template_cpp(tmpl).stats();
+}
+
+void chain_block_template_snapshot_destruct(block_template_snapshot_t snapshot) {
+    delete static_cast<bitprim::nodecint::block_template::snapshot_ptr*>(snapshot);
+}
+
+uint64_t chain_block_template_snapshot_revision(block_template_snapshot_t snapshot) {
+    return snapshot_const_cpp(snapshot).revision;
+}
+
+uint64_t /*size_t*/ chain_block_template_snapshot_height(block_template_snapshot_t snapshot) {
+    return snapshot_const_cpp(snapshot).height;
+}
+
+hash_t chain_block_template_snapshot_previous_hash(block_template_snapshot_t snapshot) {
+    return bitprim::to_hash_t(snapshot_const_cpp(snapshot).previous_hash);
+}
+
+uint64_t chain_block_template_snapshot_fees(block_template_snapshot_t snapshot) {
+    return snapshot_const_cpp(snapshot).fees;
+}
+
+uint64_t /*size_t*/ chain_block_template_snapshot_serialized_size(block_template_snapshot_t snapshot) {
+    return snapshot_const_cpp(snapshot).serialized_size;
+}
+
+uint64_t /*size_t*/ chain_block_template_snapshot_transaction_count(block_template_snapshot_t snapshot) {
+    return snapshot_const_cpp(snapshot).hashes.size();
+}
+
+hash_t chain_block_template_snapshot_transaction_hash(block_template_snapshot_t snapshot, uint64_t /*size_t*/ n) {
+    return bitprim::to_hash_t(snapshot_const_cpp(snapshot).hashes[n]);
+}
+
+//Note: It is the user's responsibility to release the handle
+transaction_ptr_t chain_block_template_snapshot_transaction(block_template_snapshot_t snapshot, uint64_t /*size_t*/ n) {
+    return chain_transaction_ptr_construct_from_cpp(snapshot_const_cpp(snapshot).transactions[n]);
+}
+
+uint64_t /*size_t*/ chain_block_template_snapshot_merkle_branch_count(block_template_snapshot_t snapshot) {
+    return snapshot_const_cpp(snapshot).merkle_branch.size();
+}
+
+hash_t chain_block_template_snapshot_merkle_branch(block_template_snapshot_t snapshot, uint64_t /*size_t*/ n) {
+    return bitprim::to_hash_t(snapshot_const_cpp(snapshot).merkle_branch[n]);
+}
+
+} /* extern "C" */
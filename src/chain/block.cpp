@@ -21,10 +21,14 @@
 
 #include <bitprim/nodecint/convertions.hpp>
 #include <bitprim/nodecint/helpers.hpp>
+#include <bitprim/nodecint/script_pattern.hpp>
+#include <bitprim/nodecint/sha256.hpp>
 
 //#include <bitprim/nodecint/chain/header.h>
 //#include <bitprim/nodecint/chain/transaction_list.h>
  #include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 
 
 libbitcoin::message::block const& chain_block_const_cpp(block_t block) {
@@ -35,6 +39,34 @@ libbitcoin::message::block& chain_block_cpp(block_t block) {
     return *static_cast<libbitcoin::message::block*>(block);
 }
 
+namespace {
+
+//Note: the transaction hashes are cached by libbitcoin, only the tree is hashed here.
+libbitcoin::hash_digest generate_merkle_root(libbitcoin::message::block const& block) {
+    auto const& txs = block.transactions();
+
+    std::vector<libbitcoin::hash_digest> hashes;
+    hashes.reserve(txs.size());
+    for (auto const& tx : txs) {
+        hashes.push_back(tx.hash());
+    }
+
+    return bitprim::sha256::merkle_root(std::move(hashes));
+}
+
+} /* end of anonymous namespace */
+
+block_ptr_t chain_block_ptr_construct_from_cpp(libbitcoin::message::block::const_ptr const& block) {
+    if ( ! block) {
+        return nullptr;
+    }
+    return new libbitcoin::message::block::const_ptr(block);
+}
+
+libbitcoin::message::block::const_ptr const& chain_block_ptr_const_cpp(block_ptr_t block) {
+    return *static_cast<libbitcoin::message::block::const_ptr const*>(block);
+}
+
 
 extern "C" {
 
@@ -57,6 +89,16 @@ void chain_block_destruct(block_t block) {
     delete &chain_block_cpp(block);
 }
 
+//Note: the returned block is read-only and it is owned by the handle, do not destruct it.
+block_t chain_block_ptr_get(block_ptr_t block) {
+    return const_cast<libbitcoin::message::block*>(chain_block_ptr_const_cpp(block).get());
+}
+
+void chain_block_ptr_release(block_ptr_t block) {
+    //Note: the handle can be null (fetch errors), it is not dereferenced
+    delete static_cast<libbitcoin::message::block::const_ptr const*>(block);
+}
+
 int /*bool*/ chain_block_is_valid(block_t block) {
     return static_cast<int>(chain_block_const_cpp(block).is_valid());
 }
@@ -143,12 +185,12 @@ uint64_t chain_block_reward(block_t block, uint64_t /*size_t*/ height) {
 //}
 
 hash_t chain_block_generate_merkle_root(block_t block) {
-    auto hash_cpp = chain_block_const_cpp(block).generate_merkle_root();
+    auto hash_cpp = generate_merkle_root(chain_block_const_cpp(block));
     return bitprim::to_hash_t(hash_cpp);
 }
 
 void chain_block_generate_merkle_root_out(block_t block, hash_t* out_merkle) {
-    auto hash_cpp = chain_block_const_cpp(block).generate_merkle_root();
+    auto hash_cpp = generate_merkle_root(chain_block_const_cpp(block));
     std::memcpy(out_merkle->hash, hash_cpp.data(), BITCOIN_HASH_SIZE);
 }
 
@@ -192,6 +234,141 @@ int /*bool*/ chain_block_is_valid_merkle_root(block_t block) {
     return static_cast<int>(chain_block_const_cpp(block).is_valid_merkle_root());
 }
 
+void chain_block_columnar_sizes(block_t block, block_columnar_t* out_columns) {
+    auto const& txs = chain_block_const_cpp(block).transactions();
+
+    out_columns->transaction_count = txs.size();
+    out_columns->input_count = 0;
+    out_columns->output_count = 0;
+    out_columns->script_size = 0;
+
+    for (auto const& tx : txs) {
+        out_columns->input_count += tx.inputs().size();
+        out_columns->output_count += tx.outputs().size();
+
+        for (auto const& output : tx.outputs()) {
+            out_columns->script_size += output.script().serialized_size(false);
+        }
+    }
+}
+
+int chain_block_to_columnar(block_t block, block_columnar_t* columns) {
+    block_columnar_t sizes;
+    chain_block_columnar_sizes(block, &sizes);
+
+    if (columns->transaction_count < sizes.transaction_count
+            || columns->input_count < sizes.input_count
+            || columns->output_count < sizes.output_count
+            || columns->script_size < sizes.script_size) {
+        return 1;
+    }
+
+    auto const& txs = chain_block_const_cpp(block).transactions();
+
+    size_t tx_index = 0;
+    size_t input_index = 0;
+    size_t output_index = 0;
+    uint64_t script_offset = 0;
+
+    for (auto const& tx : txs) {
+        if (columns->txids != nullptr) {
+            auto const& hash_cpp = tx.hash();
+            std::memcpy(columns->txids[tx_index].hash, hash_cpp.data(), BITCOIN_HASH_SIZE);
+        }
+
+        if (columns->transaction_input_counts != nullptr) {
+            columns->transaction_input_counts[tx_index] = static_cast<uint32_t>(tx.inputs().size());
+        }
+
+        if (columns->transaction_output_counts != nullptr) {
+            columns->transaction_output_counts[tx_index] = static_cast<uint32_t>(tx.outputs().size());
+        }
+
+        for (auto const& input : tx.inputs()) {
+            auto const& prevout = input.previous_output();
+
+            if (columns->prevout_hashes != nullptr) {
+                std::memcpy(columns->prevout_hashes[input_index].hash, prevout.hash().data(), BITCOIN_HASH_SIZE);
+            }
+
+            if (columns->prevout_indexes != nullptr) {
+                columns->prevout_indexes[input_index] = prevout.index();
+            }
+
+            ++input_index;
+        }
+
+        for (auto const& output : tx.outputs()) {
+            if (columns->output_values != nullptr) {
+                columns->output_values[output_index] = output.value();
+            }
+
+            if (columns->script_offsets != nullptr) {
+                columns->script_offsets[output_index] = script_offset;
+            }
+
+            auto const& script = output.script();
+            if (columns->scripts != nullptr) {
+                auto sink = libbitcoin::make_unsafe_serializer(columns->scripts + script_offset);
+                script.to_data(sink, false);
+            }
+
+            script_offset += script.serialized_size(false);
+            ++output_index;
+        }
+
+        ++tx_index;
+    }
+
+    if (columns->script_offsets != nullptr) {
+        columns->script_offsets[output_index] = script_offset;
+    }
+
+    columns->transaction_count = sizes.transaction_count;
+    columns->input_count = sizes.input_count;
+    columns->output_count = sizes.output_count;
+    columns->script_size = sizes.script_size;
+    return 0;
+}
+
+int chain_block_extract_output_destinations(block_t block, output_destination_t* out, uint64_t /*size_t*/ capacity) {
+    auto const& txs = chain_block_const_cpp(block).transactions();
+
+    uint64_t output_count = 0;
+    for (auto const& tx : txs) {
+        output_count += tx.outputs().size();
+    }
+
+    if (capacity < output_count) {
+        return 1;
+    }
+
+    //Note: one buffer for every script, they are serialized instead of parsed into operations
+    libbitcoin::data_chunk script_data;
+
+    uint32_t tx_index = 0;
+    for (auto const& tx : txs) {
+        uint32_t output_index = 0;
+        for (auto const& output : tx.outputs()) {
+            auto const& script = output.script();
+            script_data.resize(script.serialized_size(false));
+            auto sink = libbitcoin::make_unsafe_serializer(script_data.begin());
+            script.to_data(sink, false);
+
+            out->transaction_index = tx_index;
+            out->output_index = output_index;
+            std::memset(out->hash, 0, BITCOIN_SHORT_HASH_SIZE);
+            out->pattern = bitprim::nodecint::classify_output_script(script_data.data(), script_data.size(), out->hash);
+
+            ++out;
+            ++output_index;
+        }
+        ++tx_index;
+    }
+
+    return 0;
+}
+
 //
 //bool from_data(const data_chunk& data);
 //bool from_data(std::istream& stream);
@@ -21,6 +21,8 @@
 
 #include <bitprim/nodecint/convertions.hpp>
 
+#include <algorithm>
+
 std::vector<uint64_t /*size_t*/> const& chain_block_indexes_const_cpp(block_indexes_t list) {
     return *static_cast<std::vector<uint64_t /*size_t*/> const*>(list);
 }
@@ -41,20 +43,31 @@ block_indexes_t chain_block_indexes_construct_default() {
     return new std::vector<uint64_t /*size_t*/>();
 }
 
+block_indexes_t chain_block_indexes_construct_from_buffer(uint64_t const* buffer, uint64_t /*size_t*/ count) {
+    return new std::vector<uint64_t /*size_t*/>(buffer, buffer + count);
+}
+
 void chain_block_indexes_push_back(block_indexes_t list, uint64_t /*size_t*/ index) {
     chain_block_indexes_cpp(list).push_back(index);
 }
 
-void block_indexes_destruct(block_indexes_t list) {
+void chain_block_indexes_destruct(block_indexes_t list) {
     delete &chain_block_indexes_cpp(list);
 }
 
-uint64_t /*size_t*/ block_indexes_count(block_indexes_t list) {
+uint64_t /*size_t*/ chain_block_indexes_count(block_indexes_t list) {
     return chain_block_indexes_const_cpp(list).size();
 }
 
-uint64_t /*size_t*/ block_indexes_nth(block_indexes_t list, uint64_t /*size_t*/ n) {
+uint64_t /*size_t*/ chain_block_indexes_nth(block_indexes_t list, uint64_t /*size_t*/ n) {
     return chain_block_indexes_cpp(list)[n];
 }
 
-} /* extern "C" */
\ No newline at end of file
+uint64_t /*size_t*/ chain_block_indexes_copy_to(block_indexes_t list, uint64_t* buffer, uint64_t /*size_t*/ capacity) {
+    auto const& list_cpp = chain_block_indexes_const_cpp(list);
+    auto const count = std::min<uint64_t>(capacity, list_cpp.size());
+    std::copy_n(list_cpp.begin(), count, buffer);
+    return count;
+}
+
+} /* extern "C" */
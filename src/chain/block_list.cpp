@@ -39,6 +39,17 @@ block_list_t chain_block_list_construct_from_cpp(std::vector<libbitcoin::message
     return &list;
 }
 
+block_ptr_list_t chain_block_ptr_list_construct_from_cpp(libbitcoin::message::block::const_ptr_list_const_ptr const& list) {
+    if ( ! list) {
+        return nullptr;
+    }
+    return new libbitcoin::message::block::const_ptr_list_const_ptr(list);
+}
+
+libbitcoin::message::block::const_ptr_list_const_ptr const& chain_block_ptr_list_const_cpp(block_ptr_list_t list) {
+    return *static_cast<libbitcoin::message::block::const_ptr_list_const_ptr const*>(list);
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -64,4 +75,28 @@ block_t chain_block_list_nth(block_list_t list, uint64_t /*size_t*/ n) {
     return &x;
 }
 
+uint64_t /*size_t*/ chain_block_ptr_list_count(block_ptr_list_t list) {
+    //Note: the handle can be null (no blocks in the notification)
+    if (list == nullptr) {
+        return 0;
+    }
+    return chain_block_ptr_list_const_cpp(list)->size();
+}
+
+//Note: the returned block is read-only and it is owned by the handle, do not destruct it.
+block_t chain_block_ptr_list_nth(block_ptr_list_t list, uint64_t /*size_t*/ n) {
+    auto const& x = (*chain_block_ptr_list_const_cpp(list))[n];
+    return const_cast<libbitcoin::message::block*>(x.get());
+}
+
+//Note: the returned handle shares ownership of the block, it has to be released with chain_block_ptr_release.
+block_ptr_t chain_block_ptr_list_nth_shared(block_ptr_list_t list, uint64_t /*size_t*/ n) {
+    auto const& x = (*chain_block_ptr_list_const_cpp(list))[n];
+    return chain_block_ptr_construct_from_cpp(x);
+}
+
+void chain_block_ptr_list_release(block_ptr_list_t list) {
+    delete static_cast<libbitcoin::message::block::const_ptr_list_const_ptr const*>(list);
+}
+
 } /* extern "C" */
@@ -18,19 +18,48 @@
 */
 
 #include <bitprim/nodecint/chain/chain.h>
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <boost/thread/latch.hpp>
 
+#include <bitprim/nodecint/api_stats.hpp>
+#include <bitprim/nodecint/arena.hpp>
+#include <bitprim/nodecint/completion_queue.hpp>
 #include <bitprim/nodecint/convertions.hpp>
 #include <bitprim/nodecint/helpers.hpp>
+#include <bitprim/nodecint/sha256.hpp>
+#include <bitprim/nodecint/history_cursor.hpp>
+#include <bitprim/nodecint/history_multi.hpp>
+#include <bitprim/nodecint/unspent_list.hpp>
+#include <bitprim/nodecint/worker_pool.hpp>
 
+#include <bitprim/nodecint/hex.h>
 #include <bitprim/nodecint/chain/block_list.h>
+#include <bitprim/nodecint/chain/transaction.h>
 
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/message/block.hpp>
+#include <bitcoin/bitcoin/message/get_blocks.hpp>
+#include <bitcoin/bitcoin/message/get_headers.hpp>
 #include <bitcoin/bitcoin/message/header.hpp>
+#include <bitcoin/bitcoin/message/headers.hpp>
+#include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/merkle_block.hpp>
 #include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/bitcoin/message/version.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/blockchain/interface/safe_chain.hpp>
 
 namespace {
@@ -40,6 +69,27 @@ libbitcoin::blockchain::safe_chain& safe_chain(chain_t chain) {
     return *static_cast<libbitcoin::blockchain::safe_chain*>(chain);
 }
 
+inline
+void complete(completion_queue_t queue, uint64_t user_id, std::error_code const& ec, void* result, size_t height, size_t index) {
+    completion_t completion;
+    completion.user_id = user_id;
+    completion.error = ec.value();
+    completion.result = result;
+    completion.height = height;
+    completion.index = index;
+    static_cast<bitprim::nodecint::completion_queue*>(queue)->push(completion);
+}
+
+// Copies the result into the arena when there is one, otherwise into a heap object the user must destruct.
+template <typename T>
+typename std::decay<T>::type* make_result(nodecint_arena_t arena, T&& value) {
+    using type = typename std::decay<T>::type;
+    if (arena == nullptr) {
+        return new type(std::forward<T>(value));
+    }
+    return static_cast<bitprim::nodecint::arena*>(arena)->make<type>(std::forward<T>(value));
+}
+
 inline
 libbitcoin::message::transaction::const_ptr tx_shared(transaction_t tx) {
     auto const& tx_ref = *static_cast<libbitcoin::message::transaction const*>(tx);
@@ -54,6 +104,492 @@ libbitcoin::message::block::const_ptr block_shared(block_t block) {
     return libbitcoin::message::block::const_ptr(block_new);
 }
 
+// Writes the canonical serialization of message into buffer, if it fits.
+template <typename MessagePtr>
+int write_raw(std::error_code const& ec, MessagePtr const& message, uint8_t* buffer, uint64_t buffer_size, uint64_t& out_size) {
+    out_size = 0;
+
+    if (ec || ! message) {
+        return ec ? ec.value() : libbitcoin::error::not_found;
+    }
+
+    static auto const version = libbitcoin::message::version::level::canonical;
+    out_size = message->serialized_size(version);
+
+    if (buffer == nullptr || out_size > buffer_size) {
+        return libbitcoin::error::operation_failed;
+    }
+
+    auto sink = libbitcoin::make_unsafe_serializer(buffer);
+    message->to_data(version, sink);
+    return 0;
+}
+
+// Fires all the header queries at once and calls handler(error, count) when the last one completes.
+template <typename Handler>
+void fetch_headers_range(chain_t chain, uint64_t from_height, uint64_t count, uint8_t* out_headers, hash_t* out_hashes, Handler handler) {
+    struct range_state {
+        range_state(size_t count, Handler&& handler)
+            : pending(count), errors(count, 0), handler(std::move(handler))
+        {}
+
+        std::atomic<size_t> pending;
+        std::vector<int> errors;
+        Handler handler;
+    };
+
+    if (count == 0) {
+        handler(0, 0);
+        return;
+    }
+
+    auto state = std::make_shared<range_state>(count, std::move(handler));
+
+    for (size_t i = 0; i < count; ++i) {
+        safe_chain(chain).fetch_block_header(from_height + i, [state, i, out_headers, out_hashes](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t /*h*/) {
+            if ( ! ec && header) {
+                //Note: chain::header serialization, without the transaction count of message::header
+                auto sink = libbitcoin::make_unsafe_serializer(out_headers + i * BITCOIN_HEADER_SIZE);
+                static_cast<libbitcoin::chain::header const&>(*header).to_data(sink);
+
+                if (out_hashes != nullptr) {
+                    auto const& hash_cpp = header->hash();
+                    std::memcpy(out_hashes[i].hash, hash_cpp.data(), BITCOIN_HASH_SIZE);
+                }
+            } else {
+                state->errors[i] = ec ? ec.value() : libbitcoin::error::not_found;
+            }
+
+            if (state->pending.fetch_sub(1) != 1) {
+                return;
+            }
+
+            size_t written = 0;
+            while (written < state->errors.size() && state->errors[written] == 0) {
+                ++written;
+            }
+
+            auto res = written == state->errors.size() ? 0 : state->errors[written];
+            state->handler(res, written);
+        });
+    }
+}
+
+// Serializes the headers (and hashes) of the blocks in a reorganization notification.
+inline
+void pack_headers(libbitcoin::block_const_ptr_list_const_ptr const& blocks, std::vector<uint8_t>& out_headers, std::vector<hash_t>& out_hashes) {
+    if ( ! blocks) {
+        return;
+    }
+
+    out_headers.resize(blocks->size() * BITCOIN_HEADER_SIZE);
+    out_hashes.reserve(blocks->size());
+
+    auto sink = libbitcoin::make_unsafe_serializer(out_headers.data());
+    for (auto const& block : *blocks) {
+        auto const& header = block->header();
+        header.to_data(sink);
+        out_hashes.push_back(bitprim::to_hash_t(header.hash()));
+    }
+}
+
+// The locator of the last tip asked for, rebuilt when the tip changes (new block or reorganization).
+struct tip_locator {
+    chain_t chain;
+    size_t height;
+    libbitcoin::hash_digest tip;
+    libbitcoin::get_headers_const_ptr locator;
+};
+
+std::mutex tip_locator_mutex;
+tip_locator tip_locator_cache{nullptr, 0, libbitcoin::null_hash, nullptr};
+
+// Calls handler(error, locator) with the locator of the current tip. Checking the cached one costs two lookups,
+// building it costs one per locator height (O(log height)).
+template <typename Handler>
+void fetch_tip_locator(chain_t chain, Handler handler) {
+    safe_chain(chain).fetch_last_height([chain, handler](std::error_code const& ec, size_t top) {
+        if (ec) {
+            handler(ec.value(), nullptr);
+            return;
+        }
+
+        safe_chain(chain).fetch_block_header(top, [chain, top, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t /*h*/) {
+            if (ec || ! header) {
+                handler(ec ? ec.value() : libbitcoin::error::not_found, nullptr);
+                return;
+            }
+
+            auto const tip = header->hash();
+
+            libbitcoin::get_headers_const_ptr cached;
+            {
+                std::lock_guard<std::mutex> lock(tip_locator_mutex);
+                if (tip_locator_cache.chain == chain && tip_locator_cache.height == top && tip_locator_cache.tip == tip) {
+                    cached = tip_locator_cache.locator;
+                }
+            }
+
+            if (cached) {
+                handler(0, cached);
+                return;
+            }
+
+            safe_chain(chain).fetch_block_locator(libbitcoin::chain::block::locator_heights(top), [chain, top, tip, handler](std::error_code const& ec, libbitcoin::get_headers_ptr locator) {
+                if (ec || ! locator) {
+                    handler(ec ? ec.value() : libbitcoin::error::not_found, nullptr);
+                    return;
+                }
+
+                libbitcoin::get_headers_const_ptr const res = locator;
+                {
+                    std::lock_guard<std::mutex> lock(tip_locator_mutex);
+                    tip_locator_cache = tip_locator{chain, top, tip, res};
+                }
+                handler(0, res);
+            });
+        });
+    });
+}
+
+// The merkle tree of a block by levels, the transaction hashes first and the root last.
+using merkle_levels = std::vector<libbitcoin::hash_list>;
+
+// Blocks whose merkle trees are kept, the most recently used first.
+constexpr size_t merkle_tree_cache_size = 64;
+
+struct merkle_tree {
+    libbitcoin::hash_digest block_hash;
+    std::shared_ptr<merkle_levels const> levels;
+};
+
+std::mutex merkle_tree_mutex;
+std::list<merkle_tree> merkle_tree_cache;
+
+std::shared_ptr<merkle_levels const> find_merkle_tree(libbitcoin::hash_digest const& block_hash) {
+    std::lock_guard<std::mutex> lock(merkle_tree_mutex);
+
+    auto const it = std::find_if(merkle_tree_cache.begin(), merkle_tree_cache.end(), [&block_hash](merkle_tree const& tree) {
+        return tree.block_hash == block_hash;
+    });
+
+    if (it == merkle_tree_cache.end()) {
+        return nullptr;
+    }
+
+    merkle_tree_cache.splice(merkle_tree_cache.begin(), merkle_tree_cache, it);
+    return it->levels;
+}
+
+void store_merkle_tree(libbitcoin::hash_digest const& block_hash, std::shared_ptr<merkle_levels const> const& levels) {
+    std::lock_guard<std::mutex> lock(merkle_tree_mutex);
+
+    merkle_tree_cache.push_front(merkle_tree{block_hash, levels});
+    if (merkle_tree_cache.size() > merkle_tree_cache_size) {
+        merkle_tree_cache.pop_back();
+    }
+}
+
+// An odd hash at the end of a level is paired with itself.
+merkle_levels build_merkle_levels(libbitcoin::hash_list hashes) {
+    merkle_levels levels;
+    levels.push_back(std::move(hashes));
+
+    while (levels.back().size() > 1) {
+        auto const& below = levels.back();
+
+        libbitcoin::hash_list above((below.size() + 1) / 2);
+        bitprim::sha256::merkle_parents(below.data(), below.size(), above.data());
+
+        levels.push_back(std::move(above));
+    }
+
+    return levels;
+}
+
+void write_merkle_proof(merkle_levels const& levels, libbitcoin::hash_digest const& block_hash, size_t height, size_t position, merkle_proof_t& out_proof) {
+    out_proof.block_hash = bitprim::to_hash_t(block_hash);
+    out_proof.merkle_root = bitprim::to_hash_t(levels.back().front());
+    out_proof.height = height;
+    out_proof.index = position;
+    out_proof.branch_count = levels.size() - 1;
+
+    auto index = position;
+    for (size_t level = 0; level + 1 < levels.size(); ++level) {
+        auto const& hashes = levels[level];
+        auto const sibling = std::min(index ^ 1, hashes.size() - 1);
+        out_proof.branch[level] = bitprim::to_hash_t(hashes[sibling]);
+        index /= 2;
+    }
+}
+
+// Calls handler(error) after writing the proof of the confirmed transaction. On a cache miss the transaction
+// hashes of the block are read with fetch_merkle_block, without loading the transactions.
+template <typename Handler>
+void fetch_merkle_proof(chain_t chain, hash_t hash, merkle_proof_t* out_proof, Handler handler) {
+    auto const hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_transaction_position(hash_cpp, true, [chain, out_proof, handler](std::error_code const& ec, size_t position, size_t height) {
+        if (ec) {
+            handler(ec.value());
+            return;
+        }
+
+        safe_chain(chain).fetch_block_header(height, [chain, out_proof, position, height, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t /*h*/) {
+            if (ec || ! header) {
+                handler(ec ? ec.value() : libbitcoin::error::not_found);
+                return;
+            }
+
+            auto const block_hash = header->hash();
+
+            auto const cached = find_merkle_tree(block_hash);
+            if (cached) {
+                if (position >= cached->front().size()) {
+                    handler(libbitcoin::error::not_found);
+                    return;
+                }
+                write_merkle_proof(*cached, block_hash, height, position, *out_proof);
+                handler(0);
+                return;
+            }
+
+            safe_chain(chain).fetch_merkle_block(height, [out_proof, position, height, block_hash, handler](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t /*h*/) {
+                if (ec || ! block) {
+                    handler(ec ? ec.value() : libbitcoin::error::not_found);
+                    return;
+                }
+
+                //Note: the block at the height changed (reorganization) between the lookups.
+                if (block->header().hash() != block_hash || position >= block->hashes().size()) {
+                    handler(libbitcoin::error::not_found);
+                    return;
+                }
+
+                auto const levels = std::make_shared<merkle_levels const>(build_merkle_levels(block->hashes()));
+                if (levels->back().front() != block->header().merkle()) {
+                    handler(libbitcoin::error::merkle_mismatch);
+                    return;
+                }
+
+                store_merkle_tree(block_hash, levels);
+                write_merkle_proof(*levels, block_hash, height, position, *out_proof);
+                handler(0);
+            });
+        });
+    });
+}
+
+// Writes up to limit headers (BITCOIN_HEADER_SIZE bytes each) and their hashes, returns how many were written.
+inline
+size_t write_headers(libbitcoin::headers_ptr const& headers, uint64_t limit, uint8_t* out_headers, hash_t* out_hashes) {
+    if ( ! headers) {
+        return 0;
+    }
+
+    auto const& elements = headers->elements();
+    auto const count = std::min<uint64_t>(limit, elements.size());
+
+    auto sink = libbitcoin::make_unsafe_serializer(out_headers);
+    for (size_t i = 0; i < count; ++i) {
+        //Note: chain::header serialization, without the transaction count of message::header
+        static_cast<libbitcoin::chain::header const&>(elements[i]).to_data(sink);
+
+        //Note: the serialized bytes are hashed directly, the headers of a message have no cached hash
+        if (out_hashes != nullptr) {
+            bitprim::sha256::double_hash(out_headers + i * BITCOIN_HEADER_SIZE, BITCOIN_HEADER_SIZE, out_hashes[i].hash);
+        }
+    }
+
+    return count;
+}
+
+// Writes up to limit block hashes, returns how many were written.
+inline
+size_t write_inventory_hashes(libbitcoin::inventory_ptr const& inventory, uint64_t limit, hash_t* out_hashes) {
+    if ( ! inventory) {
+        return 0;
+    }
+
+    auto const& elements = inventory->inventories();
+    auto const count = std::min<uint64_t>(limit, elements.size());
+
+    for (size_t i = 0; i < count; ++i) {
+        out_hashes[i] = bitprim::to_hash_t(elements[i].hash());
+    }
+
+    return count;
+}
+
+inline
+std::vector<libbitcoin::message::transaction::const_ptr> make_tx_batch(transaction_t const* txs, uint64_t count) {
+    std::vector<libbitcoin::message::transaction::const_ptr> res;
+    res.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        res.push_back(tx_shared(txs[i]));
+    }
+    return res;
+}
+
+// Organizes the transactions in order and calls handler(invalid_count) when the last one completes.
+//Note: the transaction organizer serializes organize() under its own mutex, so the batch is not validated
+//      concurrently. In order, a transaction can spend the outputs of the previous ones in the batch.
+template <typename Handler>
+void validate_tx_batch(chain_t chain, std::vector<libbitcoin::message::transaction::const_ptr> const& txs, int* out_errors, Handler handler) {
+    struct batch_state {
+        batch_state(size_t count, Handler&& handler)
+            : pending(count), invalid(0), handler(std::move(handler))
+        {}
+
+        std::atomic<size_t> pending;
+        std::atomic<size_t> invalid;
+        Handler handler;
+    };
+
+    if (txs.empty()) {
+        handler(0);
+        return;
+    }
+
+    auto state = std::make_shared<batch_state>(txs.size(), std::move(handler));
+
+    for (size_t i = 0; i < txs.size(); ++i) {
+        safe_chain(chain).organize(txs[i], [state, i, out_errors](std::error_code const& ec) {
+            out_errors[i] = ec.value();
+
+            if (ec) {
+                ++state->invalid;
+            }
+
+            if (state->pending.fetch_sub(1) == 1) {
+                state->handler(state->invalid.load());
+            }
+        });
+    }
+}
+
+// Addresses per worker job below which posting another one does not pay off.
+constexpr size_t history_multi_grain = 16;
+
+// Looks up the history of every address in parallel and calls handler(error, history_multi*) once,
+// from the thread that completes the last lookup. The block chain reads run on the calling thread,
+// so the lookups are spread over the executor workers (bounded, joined when the executor is destructed).
+// Without workers they run on the calling thread.
+template <typename Handler>
+void fetch_history_multi(chain_t chain, payment_address_t const* addresses, uint64_t count, uint64_t limit, uint64_t from_height, bool sort_by_height, Handler handler) {
+    struct multi_state {
+        multi_state(size_t count, Handler&& handler)
+            : histories(count), errors(count), next(0), pending(count), handler(std::move(handler))
+        {}
+
+        std::vector<libbitcoin::wallet::payment_address> addresses;
+        std::vector<libbitcoin::chain::history_compact::list> histories;
+        std::vector<int> errors;
+        std::atomic<size_t> next;
+        std::atomic<size_t> pending;
+        size_t limit;
+        size_t from_height;
+        bool sort_by_height;
+        Handler handler;
+    };
+
+    auto state = std::make_shared<multi_state>(count, std::move(handler));
+    state->limit = limit;
+    state->from_height = from_height;
+    state->sort_by_height = sort_by_height;
+
+    // Copied, the caller can release its addresses as soon as this returns.
+    state->addresses.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        state->addresses.push_back(*static_cast<libbitcoin::wallet::payment_address const*>(addresses[i]));
+    }
+
+    auto complete = [state]() {
+        auto* res = new bitprim::nodecint::history_multi;
+        res->errors = std::move(state->errors);
+
+        size_t total = 0;
+        for (auto const& history : state->histories) {
+            total += history.size();
+        }
+
+        res->entries.reserve(total);
+        res->address_indexes.reserve(total);
+
+        for (size_t i = 0; i < state->histories.size(); ++i) {
+            for (auto& entry : state->histories[i]) {
+                res->entries.push_back(std::move(entry));
+                res->address_indexes.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        if (state->sort_by_height) {
+            std::vector<size_t> order(total);
+            std::iota(order.begin(), order.end(), size_t(0));
+            std::stable_sort(order.begin(), order.end(), [res](size_t a, size_t b) {
+                return res->entries[a].height < res->entries[b].height;
+            });
+
+            libbitcoin::chain::history_compact::list entries;
+            std::vector<uint32_t> address_indexes;
+            entries.reserve(total);
+            address_indexes.reserve(total);
+
+            for (auto i : order) {
+                entries.push_back(std::move(res->entries[i]));
+                address_indexes.push_back(res->address_indexes[i]);
+            }
+
+            res->entries = std::move(entries);
+            res->address_indexes = std::move(address_indexes);
+        }
+
+        auto const failed = std::find_if(res->errors.begin(), res->errors.end(), [](int error) { return error != 0; });
+        state->handler(failed == res->errors.end() ? 0 : *failed, res);
+    };
+
+    if (count == 0) {
+        complete();
+        return;
+    }
+
+    auto work = [chain, state, complete]() {
+        size_t i;
+        while ((i = state->next++) < state->addresses.size()) {
+            safe_chain(chain).fetch_history(state->addresses[i], state->limit, state->from_height, [state, i, complete](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+                state->histories[i] = std::move(history);
+                state->errors[i] = ec.value();
+
+                if (state->pending.fetch_sub(1) == 1) {
+                    complete();
+                }
+            });
+        }
+    };
+
+    auto const pool = bitprim::nodecint::find_worker_pool(chain);
+    auto const jobs = pool ? std::min<size_t>(pool->size(), (count + history_multi_grain - 1) / history_multi_grain) : 1;
+
+    //Note: every job takes the next address until there are none left, a job that is not queued runs here
+    for (size_t i = 0; i < jobs; ++i) {
+        if ( ! pool || ! pool->post(work)) {
+            work();
+        }
+    }
+}
+
+// Splits the merged history by address and writes the balance of each one.
+void write_balances(bitprim::nodecint::history_multi& history, uint64_t* out_balances, size_t count) {
+    std::vector<libbitcoin::chain::history_compact::list> by_address(count);
+    for (size_t i = 0; i < history.entries.size(); ++i) {
+        by_address[history.address_indexes[i]].push_back(std::move(history.entries[i]));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        out_balances[i] = bitprim::nodecint::make_unspent_list(by_address[i]).balance;
+    }
+}
+
 //inline
 //int char2int(char input) {
 //    if (input >= '0' && input <= '9') {
@@ -84,22 +620,26 @@ extern "C" {
 #endif
 
 void chain_fetch_last_height(chain_t chain, void* ctx, last_height_fetch_handler_t handler) {
-    safe_chain(chain).fetch_last_height([chain, ctx, handler](std::error_code const& ec, size_t h) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_last_height(bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, size_t h) {
         handler(chain, ctx, ec.value(), h);
-    });
+    }));
 }
 
 int chain_get_last_height(chain_t chain, uint64_t /*size_t*/* height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
 
     int res;
-    safe_chain(chain).fetch_last_height([&](std::error_code const& ec, size_t h) {
+    safe_chain(chain).fetch_last_height(bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, size_t h) {
        *height = h;
        res = ec.value();
        latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
@@ -114,16 +654,19 @@ int chain_get_last_height(chain_t chain, uint64_t /*size_t*/* height) {
 //}
 
 void chain_fetch_block_height(chain_t chain, void* ctx, hash_t hash, block_height_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
     auto hash_cpp = bitprim::to_array(hash.hash);
     // std::cout << "hash_cpp: " << libbitcoin::encode_hash(hash_cpp) << std::endl;
     
-    safe_chain(chain).fetch_block_height(hash_cpp, [chain, ctx, handler](std::error_code const& ec, size_t h) {
+    safe_chain(chain).fetch_block_height(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, size_t h) {
         handler(chain, ctx, ec.value(), h);
-    });
+    }));
 }
 
 int chain_get_block_height(chain_t chain, hash_t hash, uint64_t /*size_t*/* height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
@@ -131,57 +674,64 @@ int chain_get_block_height(chain_t chain, hash_t hash, uint64_t /*size_t*/* heig
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_block_height(hash_cpp, [&](std::error_code const& ec, size_t h) {
+    safe_chain(chain).fetch_block_height(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, size_t h) {
         *height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 void chain_fetch_block_header_by_height(chain_t chain, void* ctx, uint64_t /*size_t*/ height, block_header_fetch_handler_t handler) {
-    safe_chain(chain).fetch_block_header(height, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_block_header(height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
         auto new_header = new libbitcoin::message::header(*header);
 //        auto new_header = std::make_unique(*header).release();
         //Note: It is the responsability of the user to release/destruct the object
         handler(chain, ctx, ec.value(), new_header, h);
-    });
+    }));
 }
 
 int chain_get_block_header_by_height(chain_t chain, uint64_t /*size_t*/ height, header_t* out_header, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
-    safe_chain(chain).fetch_block_header(height, [&](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+    safe_chain(chain).fetch_block_header(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
         *out_header = new libbitcoin::message::header(*header);
         //Note: It is the responsability of the user to release/destruct the object
 
         *out_height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 void chain_fetch_block_header_by_hash(chain_t chain, void* ctx, hash_t hash, block_header_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
 //    libbitcoin::hash_digest hash_cpp;
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_block_header(hash_cpp, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+    safe_chain(chain).fetch_block_header(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
         auto new_header = new libbitcoin::message::header(*header);
 //        auto new_header = std::make_unique(*header).release();
         //Note: It is the responsability of the user to release/destruct the object
         handler(chain, ctx, ec.value(), new_header, h);
-    });
+    }));
 }
 
 int chain_get_block_header_by_hash(chain_t chain, hash_t hash, header_t* out_header, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
@@ -189,59 +739,148 @@ int chain_get_block_header_by_hash(chain_t chain, hash_t hash, header_t* out_hea
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_block_header(hash_cpp, [&](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+    safe_chain(chain).fetch_block_header(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
         *out_header = new libbitcoin::message::header(*header);
         //Note: It is the responsability of the user to release/destruct the object
 
         *out_height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
 
-    latch.count_down_and_wait();
+void chain_fetch_block_headers_range(chain_t chain, void* ctx, uint64_t /*size_t*/ from_height, uint64_t /*size_t*/ count, uint8_t* out_headers, hash_t* out_hashes, block_headers_range_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    fetch_headers_range(chain, from_height, count, out_headers, out_hashes, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](int error, size_t written) {
+        handler(chain, ctx, error, written);
+    }));
+}
+
+int chain_get_block_headers_range(chain_t chain, uint64_t /*size_t*/ from_height, uint64_t /*size_t*/ count, uint8_t* out_headers, hash_t* out_hashes, uint64_t /*size_t*/* out_count) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    fetch_headers_range(chain, from_height, count, out_headers, out_hashes, bitprim::nodecint::timed(call_stats, [&](int error, size_t written) {
+        *out_count = written;
+        res = error;
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_block_header_by_height_shared(chain_t chain, void* ctx, uint64_t /*size_t*/ height, block_header_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_block_header(height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), chain_header_ptr_construct_from_cpp(header), h);
+    }));
+}
+
+int chain_get_block_header_by_height_shared(chain_t chain, uint64_t /*size_t*/ height, header_ptr_t* out_header, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    safe_chain(chain).fetch_block_header(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_header = chain_header_ptr_construct_from_cpp(header);
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_block_header_by_hash_shared(chain_t chain, void* ctx, hash_t hash, block_header_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block_header(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), chain_header_ptr_construct_from_cpp(header), h);
+    }));
+}
+
+int chain_get_block_header_by_hash_shared(chain_t chain, hash_t hash, header_ptr_t* out_header, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block_header(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_header = chain_header_ptr_construct_from_cpp(header);
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 void chain_fetch_block_by_height(chain_t chain, void* ctx, uint64_t /*size_t*/ height, block_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     // safe_chain(chain).fetch_block(height, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::block::ptr block, size_t h) {
-    safe_chain(chain).fetch_block(height, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_block(height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
         auto new_block = new libbitcoin::message::block(*block);
         //Note: It is the responsability of the user to release/destruct the object
         handler(chain, ctx, ec.value(), new_block, h);
-    });
+    }));
 }
 
 int chain_get_block_by_height(chain_t chain, uint64_t /*size_t*/ height, block_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
-    safe_chain(chain).fetch_block(height, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_block(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
         *out_block = new libbitcoin::message::block(*block);
         //Note: It is the responsability of the user to release/destruct the object
 
         *out_height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 void chain_fetch_block_by_hash(chain_t chain, void* ctx, hash_t hash, block_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
 //    libbitcoin::hash_digest hash_cpp;
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_block(hash_cpp, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_block(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
         //Note: It is the responsability of the user to release/destruct the object
         auto new_block = new libbitcoin::message::block(*block);
         handler(chain, ctx, ec.value(), new_block, h);
-    });
+    }));
 }
 
 int chain_get_block_by_hash(chain_t chain, hash_t hash, block_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
@@ -249,57 +888,177 @@ int chain_get_block_by_hash(chain_t chain, hash_t hash, block_t* out_block, uint
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_block(hash_cpp, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_block(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
         //Note: It is the responsability of the user to release/destruct the object
         *out_block = new libbitcoin::message::block(*block);
         *out_height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_block_by_height_shared(chain_t chain, void* ctx, uint64_t /*size_t*/ height, block_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_block(height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), chain_block_ptr_construct_from_cpp(block), h);
+    }));
+}
+
+int chain_get_block_by_height_shared(chain_t chain, uint64_t /*size_t*/ height, block_ptr_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    safe_chain(chain).fetch_block(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_block = chain_block_ptr_construct_from_cpp(block);
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_block_by_hash_shared(chain_t chain, void* ctx, hash_t hash, block_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), chain_block_ptr_construct_from_cpp(block), h);
+    }));
+}
+
+int chain_get_block_by_hash_shared(chain_t chain, hash_t hash, block_ptr_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_block = chain_block_ptr_construct_from_cpp(block);
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_block_raw_by_height(chain_t chain, void* ctx, uint64_t /*size_t*/ height, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, block_raw_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_block(height, bitprim::nodecint::timed(call_stats, [chain, ctx, buffer, buffer_size, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        uint64_t size;
+        auto res = write_raw(ec, block, buffer, buffer_size, size);
+        handler(chain, ctx, res, size, h);
+    }));
+}
+
+int chain_get_block_raw_by_height(chain_t chain, uint64_t /*size_t*/ height, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, uint64_t /*size_t*/* out_size, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    safe_chain(chain).fetch_block(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        res = write_raw(ec, block, buffer, buffer_size, *out_size);
+        *out_height = h;
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
 
-    latch.count_down_and_wait();
+void chain_fetch_block_raw_by_hash(chain_t chain, void* ctx, hash_t hash, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, block_raw_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, buffer, buffer_size, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        uint64_t size;
+        auto res = write_raw(ec, block, buffer, buffer_size, size);
+        handler(chain, ctx, res, size, h);
+    }));
+}
+
+int chain_get_block_raw_by_hash(chain_t chain, hash_t hash, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, uint64_t /*size_t*/* out_size, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        res = write_raw(ec, block, buffer, buffer_size, *out_size);
+        *out_height = h;
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 void chain_fetch_merkle_block_by_height(chain_t chain, void* ctx, uint64_t /*size_t*/ height, merkle_block_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
-    safe_chain(chain).fetch_merkle_block(height, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_merkle_block(height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
         auto new_block = new libbitcoin::message::merkle_block(*block);
         //Note: It is the responsibility of the user to release/destruct the object
         handler(chain, ctx, ec.value(), new_block, h);
-    });
+    }));
 }
 
 int chain_get_merkle_block_by_height(chain_t chain, uint64_t /*size_t*/ height, merkle_block_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
-    safe_chain(chain).fetch_merkle_block(height, [&](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_merkle_block(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
         *out_block = new libbitcoin::message::merkle_block(*block);
         //Note: It is the responsability of the user to release/destruct the object
 
         *out_height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 void chain_fetch_merkle_block_by_hash(chain_t chain, void* ctx, hash_t hash, merkle_block_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
 //    libbitcoin::hash_digest hash_cpp;
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_merkle_block(hash_cpp, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_merkle_block(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
         auto new_block = new libbitcoin::message::merkle_block(*block);
         handler(chain, ctx, ec.value(), new_block, h);
-    });
+    }));
 }
 
 int chain_get_merkle_block_by_hash(chain_t chain, hash_t hash, merkle_block_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
@@ -307,50 +1066,175 @@ int chain_get_merkle_block_by_hash(chain_t chain, hash_t hash, merkle_block_t* o
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_merkle_block(hash_cpp, [&](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_merkle_block(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
         //Note: It is the responsability of the user to release/destruct the object
         *out_block = new libbitcoin::message::merkle_block(*block);
         *out_height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
-void chain_fetch_transaction(chain_t chain, void* ctx, hash_t hash, int require_confirmed, transaction_fetch_handler_t handler) {
-    //precondition:  [hash, 32] is a valid range
-
-//    libbitcoin::hash_digest hash_cpp;
-//    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
-    auto hash_cpp = bitprim::to_array(hash.hash);
+void chain_fetch_merkle_block_by_height_shared(chain_t chain, void* ctx, uint64_t /*size_t*/ height, merkle_block_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
-    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
-        auto new_transaction = new libbitcoin::message::transaction(*transaction);
-        handler(chain, ctx, ec.value(), new_transaction, i, h);
-    });
+    safe_chain(chain).fetch_merkle_block(height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), chain_merkle_block_ptr_construct_from_cpp(block), h);
+    }));
 }
 
-int chain_get_transaction(chain_t chain, hash_t hash, int require_confirmed, transaction_t* out_transaction, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index) {
+int chain_get_merkle_block_by_height_shared(chain_t chain, uint64_t /*size_t*/ height, merkle_block_ptr_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
-//    libbitcoin::hash_digest hash_cpp;
+    safe_chain(chain).fetch_merkle_block(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_block = chain_merkle_block_ptr_construct_from_cpp(block);
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_merkle_block_by_hash_shared(chain_t chain, void* ctx, hash_t hash, merkle_block_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_merkle_block(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), chain_merkle_block_ptr_construct_from_cpp(block), h);
+    }));
+}
+
+int chain_get_merkle_block_by_hash_shared(chain_t chain, hash_t hash, merkle_block_ptr_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_merkle_block(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::merkle_block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_block = chain_merkle_block_ptr_construct_from_cpp(block);
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_transaction(chain_t chain, void* ctx, hash_t hash, int require_confirmed, transaction_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    //precondition:  [hash, 32] is a valid range
+
+//    libbitcoin::hash_digest hash_cpp;
+//    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+        auto new_transaction = new libbitcoin::message::transaction(*transaction);
+        handler(chain, ctx, ec.value(), new_transaction, i, h);
+    }));
+}
+
+int chain_get_transaction(chain_t chain, hash_t hash, int require_confirmed, transaction_t* out_transaction, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+//    libbitcoin::hash_digest hash_cpp;
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, [&](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
         *out_transaction = new libbitcoin::message::transaction(*transaction);
         *out_height = h;
         *out_index = i;
         res = ec.value();
         latch.count_down();
-    });
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+
+}
 
-    latch.count_down_and_wait();
+void chain_fetch_transaction_raw(chain_t chain, void* ctx, hash_t hash, int require_confirmed, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, transaction_raw_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [chain, ctx, buffer, buffer_size, handler](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+        uint64_t size;
+        auto res = write_raw(ec, transaction, buffer, buffer_size, size);
+        handler(chain, ctx, res, size, i, h);
+    }));
+}
+
+int chain_get_transaction_raw(chain_t chain, hash_t hash, int require_confirmed, uint8_t* buffer, uint64_t /*size_t*/ buffer_size, uint64_t /*size_t*/* out_size, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+        res = write_raw(ec, transaction, buffer, buffer_size, *out_size);
+        *out_height = h;
+        *out_index = i;
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
+}
 
+void chain_fetch_transaction_shared(chain_t chain, void* ctx, hash_t hash, int require_confirmed, transaction_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), chain_transaction_ptr_construct_from_cpp(transaction), i, h);
+    }));
+}
+
+int chain_get_transaction_shared(chain_t chain, hash_t hash, int require_confirmed, transaction_ptr_t* out_transaction, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_transaction = chain_transaction_ptr_construct_from_cpp(transaction);
+        *out_height = h;
+        *out_index = i;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
 }
 
 //Note: Removed on 3.3.0
@@ -391,43 +1275,51 @@ int chain_get_transaction(chain_t chain, hash_t hash, int require_confirmed, tra
 // }
 
 void chain_fetch_compact_block_by_height(chain_t chain, void* ctx, uint64_t /*size_t*/ height, compact_block_fetch_handler_t handler) {
-    safe_chain(chain).fetch_compact_block(height, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_compact_block(height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
         auto new_block = new libbitcoin::message::compact_block(*block);
         //Note: It is the responsibility of the user to release/destruct the object
         handler(chain, ctx, ec.value(), new_block, h);
-    });
+    }));
 }
 
 int chain_get_compact_block_by_height(chain_t chain, uint64_t /*size_t*/ height, compact_block_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
-    safe_chain(chain).fetch_compact_block(height, [&](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_compact_block(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
         *out_block = new libbitcoin::message::compact_block(*block);
         //Note: It is the responsability of the user to release/destruct the object
 
         *out_height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 void chain_fetch_compact_block_by_hash(chain_t chain, void* ctx, hash_t hash, compact_block_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
 //    libbitcoin::hash_digest hash_cpp;
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_compact_block(hash_cpp, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_compact_block(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
         auto new_block = new libbitcoin::message::compact_block(*block);
         //Note: It is the responsibility of the user to release/destruct the object
         handler(chain, ctx, ec.value(), new_block, h);
-    });
+    }));
 }
 
 int chain_get_compact_block_by_hash(chain_t chain, hash_t hash, compact_block_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
@@ -435,29 +1327,91 @@ int chain_get_compact_block_by_hash(chain_t chain, hash_t hash, compact_block_t*
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_compact_block(hash_cpp, [&](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
+    safe_chain(chain).fetch_compact_block(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
         //Note: It is the responsability of the user to release/destruct the object
         *out_block = new libbitcoin::message::compact_block(*block);
         *out_height = h;
         res = ec.value();
         latch.count_down();
-    });
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_compact_block_by_height_shared(chain_t chain, void* ctx, uint64_t /*size_t*/ height, compact_block_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_compact_block(height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), compact_block_ptr_construct_from_cpp(block), h);
+    }));
+}
+
+int chain_get_compact_block_by_height_shared(chain_t chain, uint64_t /*size_t*/ height, compact_block_ptr_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
-    latch.count_down_and_wait();
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    safe_chain(chain).fetch_compact_block(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_block = compact_block_ptr_construct_from_cpp(block);
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_compact_block_by_hash_shared(chain_t chain, void* ctx, hash_t hash, compact_block_ptr_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_compact_block(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        handler(chain, ctx, ec.value(), compact_block_ptr_construct_from_cpp(block), h);
+    }));
+}
+
+int chain_get_compact_block_by_hash_shared(chain_t chain, hash_t hash, compact_block_ptr_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_compact_block(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::compact_block::const_ptr block, size_t h) {
+        //Note: It is the responsability of the user to release the handle
+        *out_block = compact_block_ptr_construct_from_cpp(block);
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 void chain_fetch_transaction_position(chain_t chain, void* ctx, hash_t hash, int require_confirmed, transaction_index_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
 //    libbitcoin::hash_digest hash_cpp;
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_transaction_position(hash_cpp, require_confirmed != 0, [chain, ctx, handler](std::error_code const& ec, size_t position, size_t height) {
+    safe_chain(chain).fetch_transaction_position(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, size_t position, size_t height) {
         handler(chain, ctx, ec.value(), position, height);
-    });
+    }));
 }
 
 int chain_get_transaction_position(chain_t chain, hash_t hash, int require_confirmed, uint64_t /*size_t*/* out_position, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
@@ -465,274 +1419,928 @@ int chain_get_transaction_position(chain_t chain, hash_t hash, int require_confi
 //    std::copy_n(hash, hash_cpp.size(), std::begin(hash_cpp));
     auto hash_cpp = bitprim::to_array(hash.hash);
 
-    safe_chain(chain).fetch_transaction_position(hash_cpp, require_confirmed != 0, [&](std::error_code const& ec, size_t position, size_t height) {
+    safe_chain(chain).fetch_transaction_position(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, size_t position, size_t height) {
         *out_height = height;
         *out_position = position;
         res = ec.value();
         latch.count_down();
-    });
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
 
-    latch.count_down_and_wait();
+void chain_fetch_merkle_proof(chain_t chain, void* ctx, hash_t hash, merkle_proof_t* out_proof, result_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    fetch_merkle_proof(chain, hash, out_proof, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](int error) {
+        handler(chain, ctx, error);
+    }));
+}
+
+int chain_get_merkle_proof(chain_t chain, hash_t hash, merkle_proof_t* out_proof) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    fetch_merkle_proof(chain, hash, out_proof, bitprim::nodecint::timed(call_stats, [&](int error) {
+        res = error;
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 //It is the user's responsibility to release the input point returned in the callback
 void chain_fetch_spend(chain_t chain, void* ctx, output_point_t op, spend_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     auto* outpoint_cpp = static_cast<libbitcoin::chain::output_point*>(op);
 
-    safe_chain(chain).fetch_spend(*outpoint_cpp, [chain, ctx, handler](std::error_code const& ec, libbitcoin::chain::input_point input_point) {
+    safe_chain(chain).fetch_spend(*outpoint_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::chain::input_point input_point) {
         auto new_input_point = new libbitcoin::chain::input_point(input_point);
         handler(chain, ctx, ec.value(), new_input_point);
-    });
+    }));
 }
 
 int chain_get_spend(chain_t chain, output_point_t op, input_point_t* out_input_point) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
     auto* outpoint_cpp = static_cast<libbitcoin::chain::output_point*>(op);
 
-    safe_chain(chain).fetch_spend(*outpoint_cpp, [&](std::error_code const& ec, libbitcoin::chain::input_point input_point) {
+    safe_chain(chain).fetch_spend(*outpoint_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::chain::input_point input_point) {
         *out_input_point = new libbitcoin::chain::input_point(input_point);
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
 //It is the user's responsibility to release the history returned in the callback
 void chain_fetch_history(chain_t chain, void* ctx, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
 
-    safe_chain(chain).fetch_history(address_cpp, limit, from_height, [chain, ctx, handler](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+    safe_chain(chain).fetch_history(address_cpp, limit, from_height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
         auto new_history = new libbitcoin::chain::history_compact::list(history);
         handler(chain, ctx, ec.value(), new_history);
-    });
+    }));
 }
 
 //It is the user's responsibility to release the history returned in the callback
 int chain_get_history(chain_t chain, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_compact_list_t* out_history) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
     libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
 
-    safe_chain(chain).fetch_history(address_cpp, limit, from_height, [&](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+    safe_chain(chain).fetch_history(address_cpp, limit, from_height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
         *out_history = new libbitcoin::chain::history_compact::list(history);
 
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
+//It is the user's responsibility to release the cursor returned in the callback
+void chain_fetch_history_cursor(chain_t chain, void* ctx, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_cursor_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
 
-// ------------------------------------------------------------------
-//virtual void fetch_block_locator(const chain::block::indexes& heights, block_locator_fetch_handler handler) const = 0;
-
-//void chain_fetch_block_locator(chain_t chain, void* ctx, block_indexes_t heights, block_locator_fetch_handler_t handler) {
-//    auto const& heights_cpp = chain_block_indexes_const_cpp(heights);
-//
-//    safe_chain(chain).fetch_block_locator(heights_cpp, [chain, ctx, handler](std::error_code const& ec, libbitcoin::get_headers_ptr headers) {
-//        //TODO: check if the pointer is set, before dereferencing
-//        auto* new_headers = new libbitcoin::message::get_headers(*headers);
-//        handler(chain, ctx, ec.value(), new_headers);
-//    });
-//}
-//
-////It is the user's responsibility to release the history returned in the callback
-//int chain_get_block_locator(chain_t chain, block_indexes_t heights, get_headers_ptr_t* out_headers) {
-//    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
-//    int res;
-//
-//    auto const& heights_cpp = chain_block_indexes_const_cpp(heights);
-//
-//    safe_chain(chain).fetch_block_locator(heights_cpp, [&](std::error_code const& ec, libbitcoin::get_headers_ptr headers) {
-//        //TODO: check if the pointer is set, before dereferencing
-//        *out_headers = new libbitcoin::message::get_headers(*headers);
-//        res = ec.value();
-//        latch.count_down();
-//    });
-//
-//    latch.count_down_and_wait();
-//    return res;
-//}
-
-
-
-// ------------------------------------------------------------------
-//virtual void fetch_locator_block_hashes(get_blocks_const_ptr locator, const hash_digest& threshold, size_t limit, inventory_fetch_handler handler) const = 0;
-
-//void chain_fetch_locator_block_hashes(chain_t chain, void* ctx, get_blocks_ptr_t locator, hash_t threshold, uint64_t /*size_t*/ limit, inventory_fetch_handler handler) {
-//}
-
-
-//virtual void fetch_locator_block_headers(get_headers_const_ptr locator, const hash_digest& threshold, size_t limit, locator_block_headers_fetch_handler handler) const = 0;
-//
+    safe_chain(chain).fetch_history(address_cpp, limit, from_height, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        auto cursor = new bitprim::nodecint::history_cursor(std::move(history));
+        handler(chain, ctx, ec.value(), cursor);
+    }));
+}
 
-//// Transaction Pool.
-////-------------------------------------------------------------------------
-//
-//virtual void fetch_template(merkle_block_fetch_handler handler) const = 0;
-//virtual void fetch_mempool(size_t count_limit, uint64_t minimum_fee, inventory_fetch_handler handler) const = 0;
-//
-//// Filters.
-////-------------------------------------------------------------------------
-//
-//virtual void filter_blocks(get_data_ptr message, result_handler handler) const = 0;
+//It is the user's responsibility to release the cursor returned
+int chain_get_history_cursor(chain_t chain, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_cursor_t* out_cursor) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
-//void chain_filter_blocks(chain_t chain, void* ctx, get_data_ptr message, result_handler handler) {
-//}
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
 
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
 
-//virtual void filter_transactions(get_data_ptr message, result_handler handler) const = 0;
-// ------------------------------------------------------------------
+    safe_chain(chain).fetch_history(address_cpp, limit, from_height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        *out_cursor = new bitprim::nodecint::history_cursor(std::move(history));
 
+        res = ec.value();
+        latch.count_down();
+    }));
 
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
 
+void chain_fetch_history_chunked(chain_t chain, void* ctx, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, uint64_t /*size_t*/ chunk_size, history_chunk_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+    chunk_size = std::max<uint64_t>(chunk_size, 1);
+
+    safe_chain(chain).fetch_history(address_cpp, limit, from_height, bitprim::nodecint::timed(call_stats, [chain, ctx, chunk_size, handler](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        // A single chunk buffer, reused for every call.
+        libbitcoin::chain::history_compact::list chunk;
+        chunk.reserve(std::min<size_t>(chunk_size, history.size()));
+
+        auto it = history.begin();
+        do {
+            auto const last = std::next(it, std::min<size_t>(chunk_size, std::distance(it, history.end())));
+            chunk.assign(std::make_move_iterator(it), std::make_move_iterator(last));
+            it = last;
+
+            auto const is_last = it == history.end();
+            if (handler(chain, ctx, ec.value(), &chunk, static_cast<int>(is_last)) == 0) {
+                break;
+            }
+        } while (it != history.end());
+    }));
+}
 
+//It is the user's responsibility to release the history returned in the callback
+void chain_fetch_history_multi(chain_t chain, void* ctx, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, int sort_by_height, history_multi_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
-// Subscribers.
-//-------------------------------------------------------------------------
+    fetch_history_multi(chain, addresses, count, limit, from_height, sort_by_height != 0, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](int error, bitprim::nodecint::history_multi* history) {
+        handler(chain, ctx, error, history);
+    }));
+}
 
-//virtual void subscribe_blockchain(reorganize_handler&& handler) = 0;
-//virtual void subscribe_transaction(transaction_handler&& handler) = 0;
+//It is the user's responsibility to release the history returned
+int chain_get_history_multi(chain_t chain, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, int sort_by_height, history_multi_t* out_history) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
-void chain_subscribe_blockchain(executor_t exec, chain_t chain, void* ctx, subscribe_blockchain_handler_t handler) {
-    safe_chain(chain).subscribe_blockchain([exec, chain, ctx, handler](std::error_code const& ec, size_t fork_height, libbitcoin::block_const_ptr_list_const_ptr incoming, libbitcoin::block_const_ptr_list_const_ptr replaced_blocks) {
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
 
-        block_list_t incoming_cpp = nullptr;
-        if (incoming) {
-            incoming_cpp = chain_block_list_construct_default();
-            for (auto&& x : *incoming) {
-                auto new_block = new libbitcoin::message::block(*x);
-                chain_block_list_push_back(incoming_cpp, new_block);
-            }
-        }
+    fetch_history_multi(chain, addresses, count, limit, from_height, sort_by_height != 0, bitprim::nodecint::timed(call_stats, [&](int error, bitprim::nodecint::history_multi* history) {
+        *out_history = history;
 
-        block_list_t replaced_blocks_cpp = nullptr;
-        if (replaced_blocks) {
-            replaced_blocks_cpp = chain_block_list_construct_default();
-            for (auto&& x : *replaced_blocks) {
-                auto new_block = new libbitcoin::message::block(*x);
-                chain_block_list_push_back(replaced_blocks_cpp, new_block);
-            }
-        }
-        
-        auto res = handler(exec, chain, ctx, ec.value(), fork_height, incoming_cpp, replaced_blocks_cpp);
-        return res;
-    });
-}
+        res = error;
+        latch.count_down();
+    }));
 
-void chain_subscribe_transaction(executor_t exec, chain_t chain, void* ctx, subscribe_transaction_handler_t handler) {
-    safe_chain(chain).subscribe_transaction([exec, chain, ctx, handler](std::error_code const& ec, libbitcoin::transaction_const_ptr tx) {
-        auto new_tx = new libbitcoin::message::transaction(*tx);
-        return handler(exec, chain, ctx, ec.value(), new_tx);
-    });
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
 }
 
-void chain_unsubscribe(chain_t chain) {
-    safe_chain(chain).unsubscribe();
-}
 
-// Organizers.
-//-------------------------------------------------------------------------
+//It is the user's responsibility to release the unspent outputs returned in the callback
+void chain_fetch_unspent_outputs(chain_t chain, void* ctx, payment_address_t address, unspent_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
 
-//virtual void organize(block_const_ptr block, result_handler handler) = 0;
-//virtual void organize(transaction_const_ptr tx, result_handler handler) = 0;
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
 
-void chain_organize_block(chain_t chain, void* ctx, block_t block, result_handler_t handler) {
-    safe_chain(chain).organize(block_shared(block), [chain, ctx, handler](std::error_code const& ec) {
-        handler(chain, ctx, ec.value());
-    });
+    safe_chain(chain).fetch_history(address_cpp, 0, 0, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        auto new_unspent = new bitprim::nodecint::unspent_list(bitprim::nodecint::make_unspent_list(history));
+        handler(chain, ctx, ec.value(), new_unspent);
+    }));
 }
 
-int chain_organize_block_sync(chain_t chain, block_t block) {
+//It is the user's responsibility to release the unspent outputs returned
+int chain_get_unspent_outputs(chain_t chain, payment_address_t address, unspent_list_t* out_unspent) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
-    safe_chain(chain).organize(block_shared(block), [&](std::error_code const& ec) {
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+
+    safe_chain(chain).fetch_history(address_cpp, 0, 0, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        *out_unspent = new bitprim::nodecint::unspent_list(bitprim::nodecint::make_unspent_list(history));
+
         res = ec.value();
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
-void chain_organize_transaction(chain_t chain, void* ctx, transaction_t transaction, result_handler_t handler) {
-    safe_chain(chain).organize(tx_shared(transaction), [chain, ctx, handler](std::error_code const& ec) {
-        handler(chain, ctx, ec.value());
-    });
+void chain_fetch_balances(chain_t chain, void* ctx, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t* out_balances, result_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    fetch_history_multi(chain, addresses, count, 0, 0, false, bitprim::nodecint::timed(call_stats, [chain, ctx, count, out_balances, handler](int error, bitprim::nodecint::history_multi* history) {
+        write_balances(*history, out_balances, count);
+        delete history;
+        handler(chain, ctx, error);
+    }));
 }
 
-int chain_organize_transaction_sync(chain_t chain, transaction_t transaction) {
+int chain_get_balances(chain_t chain, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t* out_balances) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
     boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
     int res;
 
-    safe_chain(chain).organize(tx_shared(transaction), [&](std::error_code const& ec) {
-        res = ec.value();
+    fetch_history_multi(chain, addresses, count, 0, 0, false, bitprim::nodecint::timed(call_stats, [&](int error, bitprim::nodecint::history_multi* history) {
+        write_balances(*history, out_balances, count);
+        delete history;
+
+        res = error;
         latch.count_down();
-    });
+    }));
 
-    latch.count_down_and_wait();
+    bitprim::nodecint::timed_wait(latch, call_stats);
     return res;
 }
 
+
+// Completion Queue.
 //-------------------------------------------------------------------------
 
-////It is the user's responsibility to release the transaction returned
-//transaction_t chain_hex_to_tx(char const* tx_hex) {
-//
-//    static auto const version = libbitcoin::message::version::level::canonical;
-//
-////    auto const tx = std::make_shared<libbitcoin::message::transaction>();
-//    auto* tx = new libbitcoin::message::transaction;
-//
-//    std::string tx_hex_cpp(tx_hex);
-//    std::vector<uint8_t> data(tx_hex_cpp.size() / 2); // (tx_hex_cpp.begin(), tx_hex_cpp.end());
-//    //data.reserve(tx_hex_cpp.size() / 2);
-//
-//    hex2bin(tx_hex_cpp.c_str(), data.data());
-//
-//    if (!tx->from_data(version, data)) {
-//        return nullptr;
-//    }
+void chain_submit_last_height(chain_t chain, completion_queue_t queue, uint64_t user_id) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, size_t h) {
+        complete(queue, user_id, ec, nullptr, h, 0);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, handler]() {
+        safe_chain(chain).fetch_last_height(handler);
+    });
+}
+
+void chain_submit_block_height(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, size_t h) {
+        complete(queue, user_id, ec, nullptr, h, 0);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, hash_cpp, handler]() {
+        safe_chain(chain).fetch_block_height(hash_cpp, handler);
+    });
+}
+
+void chain_submit_block_header_by_height(chain_t chain, completion_queue_t queue, uint64_t user_id, uint64_t /*size_t*/ height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        complete(queue, user_id, ec, chain_header_ptr_construct_from_cpp(header), h, 0);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, height, handler]() {
+        safe_chain(chain).fetch_block_header(height, handler);
+    });
+}
+
+void chain_submit_block_header_by_hash(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        complete(queue, user_id, ec, chain_header_ptr_construct_from_cpp(header), h, 0);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, hash_cpp, handler]() {
+        safe_chain(chain).fetch_block_header(hash_cpp, handler);
+    });
+}
+
+void chain_submit_block_by_height(chain_t chain, completion_queue_t queue, uint64_t user_id, uint64_t /*size_t*/ height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        complete(queue, user_id, ec, chain_block_ptr_construct_from_cpp(block), h, 0);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, height, handler]() {
+        safe_chain(chain).fetch_block(height, handler);
+    });
+}
+
+void chain_submit_block_by_hash(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        complete(queue, user_id, ec, chain_block_ptr_construct_from_cpp(block), h, 0);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, hash_cpp, handler]() {
+        safe_chain(chain).fetch_block(hash_cpp, handler);
+    });
+}
+
+void chain_submit_transaction(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash, int require_confirmed) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+        complete(queue, user_id, ec, chain_transaction_ptr_construct_from_cpp(transaction), h, i);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, hash_cpp, require_confirmed, handler]() {
+        safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, handler);
+    });
+}
+
+void chain_submit_transaction_position(chain_t chain, completion_queue_t queue, uint64_t user_id, hash_t hash, int require_confirmed) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, size_t position, size_t height) {
+        complete(queue, user_id, ec, nullptr, height, position);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, hash_cpp, require_confirmed, handler]() {
+        safe_chain(chain).fetch_transaction_position(hash_cpp, require_confirmed != 0, handler);
+    });
+}
+
+void chain_submit_history(chain_t chain, completion_queue_t queue, uint64_t user_id, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    //Note: copied, the caller can release the address as soon as this returns
+    auto const address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+
+    auto handler = bitprim::nodecint::timed(call_stats, [queue, user_id](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        auto new_history = new libbitcoin::chain::history_compact::list(std::move(history));
+        complete(queue, user_id, ec, new_history, 0, 0);
+    });
+
+    bitprim::nodecint::post_or_run(chain, [chain, address_cpp, limit, from_height, handler]() {
+        safe_chain(chain).fetch_history(address_cpp, limit, from_height, handler);
+    });
+}
+
+
+// Locators.
+//-------------------------------------------------------------------------
+
+block_indexes_t chain_block_locator_heights(uint64_t /*size_t*/ top) {
+    auto const heights = libbitcoin::chain::block::locator_heights(top);
+    return new std::vector<uint64_t /*size_t*/>(heights.begin(), heights.end());
+}
+
+//It is the user's responsibility to release the locator returned in the callback
+void chain_fetch_block_locator(chain_t chain, void* ctx, block_indexes_t heights, block_locator_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto const& heights_ref = chain_block_indexes_const_cpp(heights);
+    libbitcoin::chain::block::indexes heights_cpp(heights_ref.begin(), heights_ref.end());
+
+    safe_chain(chain).fetch_block_locator(heights_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec, libbitcoin::get_headers_ptr headers) {
+        auto* new_headers = headers ? new libbitcoin::message::get_headers(*headers) : nullptr;
+        handler(chain, ctx, ec.value(), new_headers);
+    }));
+}
+
+//It is the user's responsibility to release the locator returned
+int chain_get_block_locator(chain_t chain, block_indexes_t heights, get_headers_ptr_t* out_headers) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto const& heights_ref = chain_block_indexes_const_cpp(heights);
+    libbitcoin::chain::block::indexes heights_cpp(heights_ref.begin(), heights_ref.end());
+
+    safe_chain(chain).fetch_block_locator(heights_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::get_headers_ptr headers) {
+        *out_headers = headers ? new libbitcoin::message::get_headers(*headers) : nullptr;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+//It is the user's responsibility to release the locator returned in the callback
+void chain_fetch_tip_locator(chain_t chain, void* ctx, block_locator_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    fetch_tip_locator(chain, bitprim::nodecint::timed(call_stats, [chain, ctx, handler](int error, libbitcoin::get_headers_const_ptr locator) {
+        auto* new_locator = locator ? new libbitcoin::message::get_headers(*locator) : nullptr;
+        handler(chain, ctx, error, new_locator);
+    }));
+}
+
+//It is the user's responsibility to release the locator returned
+int chain_get_tip_locator(chain_t chain, get_headers_ptr_t* out_headers) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    fetch_tip_locator(chain, bitprim::nodecint::timed(call_stats, [&](int error, libbitcoin::get_headers_const_ptr locator) {
+        *out_headers = locator ? new libbitcoin::message::get_headers(*locator) : nullptr;
+        res = error;
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_locator_block_hashes(chain_t chain, void* ctx, get_blocks_t locator, hash_t threshold, uint64_t /*size_t*/ limit, hash_t* out_hashes, locator_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto locator_cpp = std::make_shared<libbitcoin::message::get_blocks const>(chain_get_blocks_const_cpp(locator));
+    auto threshold_cpp = bitprim::to_array(threshold.hash);
+
+    safe_chain(chain).fetch_locator_block_hashes(locator_cpp, threshold_cpp, limit, bitprim::nodecint::timed(call_stats, [chain, ctx, limit, out_hashes, handler](std::error_code const& ec, libbitcoin::inventory_ptr inventory) {
+        handler(chain, ctx, ec.value(), write_inventory_hashes(inventory, limit, out_hashes));
+    }));
+}
+
+int chain_get_locator_block_hashes(chain_t chain, get_blocks_t locator, hash_t threshold, uint64_t /*size_t*/ limit, hash_t* out_hashes, uint64_t /*size_t*/* out_count) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto locator_cpp = std::make_shared<libbitcoin::message::get_blocks const>(chain_get_blocks_const_cpp(locator));
+    auto threshold_cpp = bitprim::to_array(threshold.hash);
+
+    safe_chain(chain).fetch_locator_block_hashes(locator_cpp, threshold_cpp, limit, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::inventory_ptr inventory) {
+        *out_count = write_inventory_hashes(inventory, limit, out_hashes);
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_locator_block_headers(chain_t chain, void* ctx, get_headers_t locator, hash_t threshold, uint64_t /*size_t*/ limit, uint8_t* out_headers, hash_t* out_hashes, locator_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto locator_cpp = std::make_shared<libbitcoin::message::get_headers const>(chain_get_headers_const_cpp(locator));
+    auto threshold_cpp = bitprim::to_array(threshold.hash);
+
+    safe_chain(chain).fetch_locator_block_headers(locator_cpp, threshold_cpp, limit, bitprim::nodecint::timed(call_stats, [chain, ctx, limit, out_headers, out_hashes, handler](std::error_code const& ec, libbitcoin::headers_ptr headers) {
+        handler(chain, ctx, ec.value(), write_headers(headers, limit, out_headers, out_hashes));
+    }));
+}
+
+int chain_get_locator_block_headers(chain_t chain, get_headers_t locator, hash_t threshold, uint64_t /*size_t*/ limit, uint8_t* out_headers, hash_t* out_hashes, uint64_t /*size_t*/* out_count) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto locator_cpp = std::make_shared<libbitcoin::message::get_headers const>(chain_get_headers_const_cpp(locator));
+    auto threshold_cpp = bitprim::to_array(threshold.hash);
+
+    safe_chain(chain).fetch_locator_block_headers(locator_cpp, threshold_cpp, limit, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::headers_ptr headers) {
+        *out_count = write_headers(headers, limit, out_headers, out_hashes);
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+//// Transaction Pool.
+////-------------------------------------------------------------------------
 //
-//    // Simulate organization into our chain.
-//    tx->validation.simulate = true;
+//virtual void fetch_template(merkle_block_fetch_handler handler) const = 0;
+//virtual void fetch_mempool(size_t count_limit, uint64_t minimum_fee, inventory_fetch_handler handler) const = 0;
+//
+//// Filters.
+////-------------------------------------------------------------------------
 //
-//    return tx;
+//virtual void filter_blocks(get_data_ptr message, result_handler handler) const = 0;
+
+//void chain_filter_blocks(chain_t chain, void* ctx, get_data_ptr message, result_handler handler) {
 //}
 
+
+//virtual void filter_transactions(get_data_ptr message, result_handler handler) const = 0;
+// ------------------------------------------------------------------
+
+
+
+
+
+
+// Subscribers.
+//-------------------------------------------------------------------------
+
+//virtual void subscribe_blockchain(reorganize_handler&& handler) = 0;
+//virtual void subscribe_transaction(transaction_handler&& handler) = 0;
+
+void chain_subscribe_blockchain(executor_t exec, chain_t chain, void* ctx, subscribe_blockchain_handler_t handler) {
+    safe_chain(chain).subscribe_blockchain([exec, chain, ctx, handler](std::error_code const& ec, size_t fork_height, libbitcoin::block_const_ptr_list_const_ptr incoming, libbitcoin::block_const_ptr_list_const_ptr replaced_blocks) {
+
+        block_list_t incoming_cpp = nullptr;
+        if (incoming) {
+            incoming_cpp = chain_block_list_construct_default();
+            auto& list = chain_block_list_cpp(incoming_cpp);
+            list.reserve(incoming->size());
+            for (auto&& x : *incoming) {
+                list.push_back(*x);
+            }
+        }
+
+        block_list_t replaced_blocks_cpp = nullptr;
+        if (replaced_blocks) {
+            replaced_blocks_cpp = chain_block_list_construct_default();
+            auto& list = chain_block_list_cpp(replaced_blocks_cpp);
+            list.reserve(replaced_blocks->size());
+            for (auto&& x : *replaced_blocks) {
+                list.push_back(*x);
+            }
+        }
+        
+        auto res = handler(exec, chain, ctx, ec.value(), fork_height, incoming_cpp, replaced_blocks_cpp);
+        return res;
+    });
+}
+
+void chain_subscribe_blockchain_shared(executor_t exec, chain_t chain, void* ctx, subscribe_blockchain_shared_handler_t handler) {
+    safe_chain(chain).subscribe_blockchain([exec, chain, ctx, handler](std::error_code const& ec, size_t fork_height, libbitcoin::block_const_ptr_list_const_ptr incoming, libbitcoin::block_const_ptr_list_const_ptr replaced_blocks) {
+        //Note: It is the responsability of the user to release the handles
+        auto incoming_cpp = chain_block_ptr_list_construct_from_cpp(incoming);
+        auto replaced_blocks_cpp = chain_block_ptr_list_construct_from_cpp(replaced_blocks);
+        return handler(exec, chain, ctx, ec.value(), fork_height, incoming_cpp, replaced_blocks_cpp);
+    });
+}
+
+void chain_subscribe_blockchain_headers(executor_t exec, chain_t chain, void* ctx, subscribe_blockchain_headers_handler_t handler) {
+    safe_chain(chain).subscribe_blockchain([exec, chain, ctx, handler](std::error_code const& ec, size_t fork_height, libbitcoin::block_const_ptr_list_const_ptr incoming, libbitcoin::block_const_ptr_list_const_ptr replaced_blocks) {
+        std::vector<uint8_t> incoming_headers;
+        std::vector<hash_t> incoming_hashes;
+        std::vector<uint8_t> replaced_headers;
+        std::vector<hash_t> replaced_hashes;
+
+        pack_headers(incoming, incoming_headers, incoming_hashes);
+        pack_headers(replaced_blocks, replaced_headers, replaced_hashes);
+
+        return handler(exec, chain, ctx, ec.value(), fork_height,
+                       incoming_hashes.size(), incoming_headers.data(), incoming_hashes.data(),
+                       replaced_hashes.size(), replaced_headers.data(), replaced_hashes.data());
+    });
+}
+
+void chain_subscribe_transaction(executor_t exec, chain_t chain, void* ctx, subscribe_transaction_handler_t handler) {
+    safe_chain(chain).subscribe_transaction([exec, chain, ctx, handler](std::error_code const& ec, libbitcoin::transaction_const_ptr tx) {
+        //Note: tx is null when the subscription is stopped.
+        auto new_tx = tx ? new libbitcoin::message::transaction(*tx) : nullptr;
+        return handler(exec, chain, ctx, ec.value(), new_tx);
+    });
+}
+
+void chain_unsubscribe(chain_t chain) {
+    safe_chain(chain).unsubscribe();
+}
+
+// Organizers.
+//-------------------------------------------------------------------------
+
+//virtual void organize(block_const_ptr block, result_handler handler) = 0;
+//virtual void organize(transaction_const_ptr tx, result_handler handler) = 0;
+
+void chain_organize_block(chain_t chain, void* ctx, block_t block, result_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).organize(block_shared(block), bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec) {
+        handler(chain, ctx, ec.value());
+    }));
+}
+
+int chain_organize_block_sync(chain_t chain, block_t block) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    safe_chain(chain).organize(block_shared(block), bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec) {
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_organize_transaction(chain_t chain, void* ctx, transaction_t transaction, result_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).organize(tx_shared(transaction), bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec) {
+        handler(chain, ctx, ec.value());
+    }));
+}
+
+int chain_organize_transaction_sync(chain_t chain, transaction_t transaction) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    safe_chain(chain).organize(tx_shared(transaction), bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec) {
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+//-------------------------------------------------------------------------
+
+//It is the user's responsibility to release the transaction returned
+transaction_t hex_to_tx(char const* tx_hex) {
+    static auto const version = libbitcoin::message::version::level::canonical;
+
+    auto const hex_size = std::strlen(tx_hex);
+    std::vector<uint8_t> data(hex_size / 2);
+
+    if ( ! hex_decode(tx_hex, hex_size, data.data())) {
+        return nullptr;
+    }
+
+    auto* tx = static_cast<libbitcoin::message::transaction*>(chain_transaction_factory_from_data(version, data.data(), data.size()));
+    if (tx == nullptr) {
+        return nullptr;
+    }
+
+    // Simulate organization into our chain.
+    tx->validation.simulate = true;
+    return tx;
+}
+
 void chain_validate_tx(chain_t chain, void* ctx, transaction_t tx, validate_tx_handler_t handler) {
-    safe_chain(chain).organize(tx_shared(tx), [chain, ctx, handler](std::error_code const& ec) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).organize(tx_shared(tx), bitprim::nodecint::timed(call_stats, [chain, ctx, handler](std::error_code const& ec) {
 //        auto is_error = (bool)ec;
         if (handler != nullptr) {
             if (ec) {
-                auto* msg_str = new std::string(ec.message());
-                handler(chain, ctx, ec.value(), msg_str->c_str());
+                //Note: the message is only valid during the handler call
+                auto const msg_str = ec.message();
+                handler(chain, ctx, ec.value(), msg_str.c_str());
             } else {
                 handler(chain, ctx, ec.value(), nullptr);
             }
         }
+    }));
+}
+
+void chain_validate_tx_batch(chain_t chain, void* ctx, transaction_t const* txs, uint64_t /*size_t*/ count, int* out_errors, validate_tx_batch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    //Note: copied here, the caller can release its transactions as soon as this returns
+    auto batch = std::make_shared<std::vector<libbitcoin::message::transaction::const_ptr>>(make_tx_batch(txs, count));
+
+    auto done = bitprim::nodecint::timed(call_stats, [chain, ctx, handler](size_t invalid_count) {
+        if (handler != nullptr) {
+            handler(chain, ctx, invalid_count);
+        }
+    });
+
+    //Note: the organizes run on the executor workers, this returns at once
+    bitprim::nodecint::post_or_run(chain, [chain, batch, out_errors, done]() {
+        validate_tx_batch(chain, *batch, out_errors, done);
     });
 }
 
+uint64_t /*size_t*/ chain_validate_tx_batch_sync(chain_t chain, transaction_t const* txs, uint64_t /*size_t*/ count, int* out_errors) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    size_t res;
+
+    validate_tx_batch(chain, make_tx_batch(txs, count), out_errors, bitprim::nodecint::timed(call_stats, [&](size_t invalid_count) {
+        res = invalid_count;
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+// Arena allocated results ---------------------------------------------------------
+//Note: the null checks cover the error paths, where libbitcoin returns an empty pointer.
+
+void chain_fetch_block_header_by_height_arena(chain_t chain, void* ctx, nodecint_arena_t arena, uint64_t /*size_t*/ height, block_header_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_block_header(height, bitprim::nodecint::timed(call_stats, [chain, ctx, arena, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        handler(chain, ctx, ec.value(), header ? make_result(arena, *header) : nullptr, h);
+    }));
+}
+
+int chain_get_block_header_by_height_arena(chain_t chain, nodecint_arena_t arena, uint64_t /*size_t*/ height, header_t* out_header, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    safe_chain(chain).fetch_block_header(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        *out_header = header ? make_result(arena, *header) : nullptr;
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_block_header_by_hash_arena(chain_t chain, void* ctx, nodecint_arena_t arena, hash_t hash, block_header_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block_header(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, arena, handler](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        handler(chain, ctx, ec.value(), header ? make_result(arena, *header) : nullptr, h);
+    }));
+}
+
+int chain_get_block_header_by_hash_arena(chain_t chain, nodecint_arena_t arena, hash_t hash, header_t* out_header, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block_header(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::header::ptr header, size_t h) {
+        *out_header = header ? make_result(arena, *header) : nullptr;
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_block_by_height_arena(chain_t chain, void* ctx, nodecint_arena_t arena, uint64_t /*size_t*/ height, block_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    safe_chain(chain).fetch_block(height, bitprim::nodecint::timed(call_stats, [chain, ctx, arena, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        handler(chain, ctx, ec.value(), block ? make_result(arena, *block) : nullptr, h);
+    }));
+}
+
+int chain_get_block_by_height_arena(chain_t chain, nodecint_arena_t arena, uint64_t /*size_t*/ height, block_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    safe_chain(chain).fetch_block(height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        *out_block = block ? make_result(arena, *block) : nullptr;
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_block_by_hash_arena(chain_t chain, void* ctx, nodecint_arena_t arena, hash_t hash, block_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block(hash_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, arena, handler](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        handler(chain, ctx, ec.value(), block ? make_result(arena, *block) : nullptr, h);
+    }));
+}
+
+int chain_get_block_by_hash_arena(chain_t chain, nodecint_arena_t arena, hash_t hash, block_t* out_block, uint64_t /*size_t*/* out_height) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_block(hash_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t h) {
+        *out_block = block ? make_result(arena, *block) : nullptr;
+        *out_height = h;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_transaction_arena(chain_t chain, void* ctx, nodecint_arena_t arena, hash_t hash, int require_confirmed, transaction_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [chain, ctx, arena, handler](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+        handler(chain, ctx, ec.value(), transaction ? make_result(arena, *transaction) : nullptr, i, h);
+    }));
+}
+
+int chain_get_transaction_arena(chain_t chain, nodecint_arena_t arena, hash_t hash, int require_confirmed, transaction_t* out_transaction, uint64_t /*size_t*/* out_height, uint64_t /*size_t*/* out_index) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto hash_cpp = bitprim::to_array(hash.hash);
+
+    safe_chain(chain).fetch_transaction(hash_cpp, require_confirmed != 0, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::message::transaction::const_ptr transaction, size_t i, size_t h) {
+        *out_transaction = transaction ? make_result(arena, *transaction) : nullptr;
+        *out_height = h;
+        *out_index = i;
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_spend_arena(chain_t chain, void* ctx, nodecint_arena_t arena, output_point_t op, spend_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    auto* outpoint_cpp = static_cast<libbitcoin::chain::output_point*>(op);
+
+    safe_chain(chain).fetch_spend(*outpoint_cpp, bitprim::nodecint::timed(call_stats, [chain, ctx, arena, handler](std::error_code const& ec, libbitcoin::chain::input_point input_point) {
+        handler(chain, ctx, ec.value(), make_result(arena, std::move(input_point)));
+    }));
+}
+
+int chain_get_spend_arena(chain_t chain, nodecint_arena_t arena, output_point_t op, input_point_t* out_input_point) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    auto* outpoint_cpp = static_cast<libbitcoin::chain::output_point*>(op);
+
+    safe_chain(chain).fetch_spend(*outpoint_cpp, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::chain::input_point input_point) {
+        *out_input_point = make_result(arena, std::move(input_point));
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
+void chain_fetch_history_arena(chain_t chain, void* ctx, nodecint_arena_t arena, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_fetch_handler_t handler) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+
+    safe_chain(chain).fetch_history(address_cpp, limit, from_height, bitprim::nodecint::timed(call_stats, [chain, ctx, arena, handler](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        handler(chain, ctx, ec.value(), make_result(arena, std::move(history)));
+    }));
+}
+
+int chain_get_history_arena(chain_t chain, nodecint_arena_t arena, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_compact_list_t* out_history) {
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+
+    safe_chain(chain).fetch_history(address_cpp, limit, from_height, bitprim::nodecint::timed(call_stats, [&](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        *out_history = make_result(arena, std::move(history));
+        res = ec.value();
+        latch.count_down();
+    }));
+
+    bitprim::nodecint::timed_wait(latch, call_stats);
+    return res;
+}
+
 void chain_fetch_stealth(chain_t chain, void* ctx, binary_t filter, uint64_t from_height, stealth_fetch_handler_t handler){
+    static auto& call_stats = bitprim::nodecint::api_stats_entry(__func__);
+
 	auto* filter_cpp_ptr = static_cast<const libbitcoin::binary*>(filter);
 	libbitcoin::binary const& filter_cpp  = *filter_cpp_ptr;
 
-    safe_chain(chain).fetch_stealth(filter_cpp, from_height, [chain,ctx,handler](std::error_code const& ec, libbitcoin::chain::stealth_compact::list stealth){
+    safe_chain(chain).fetch_stealth(filter_cpp, from_height, bitprim::nodecint::timed(call_stats, [chain,ctx,handler](std::error_code const& ec, libbitcoin::chain::stealth_compact::list stealth){
         auto new_stealth = new libbitcoin::chain::stealth_compact::list(stealth);
         handler(chain, ctx, ec.value(), new_stealth);
-    });
+    }));
 } 
 
 } /* extern "C" */
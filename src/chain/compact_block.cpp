@@ -18,6 +18,8 @@
  */
 
 #include <bitprim/nodecint/chain/compact_block.h>
+
+#include <bitprim/nodecint/convertions.hpp>
 #include <bitcoin/bitcoin/message/compact_block.hpp>
 
 namespace {
@@ -32,6 +34,17 @@ libbitcoin::message::compact_block &compact_block_cpp(compact_block_t block) {
 
 } /* end of anonymous namespace */
 
+compact_block_ptr_t compact_block_ptr_construct_from_cpp(libbitcoin::message::compact_block::const_ptr const& block) {
+    if ( ! block) {
+        return nullptr;
+    }
+    return new libbitcoin::message::compact_block::const_ptr(block);
+}
+
+libbitcoin::message::compact_block::const_ptr const& compact_block_ptr_const_cpp(compact_block_ptr_t block) {
+    return *static_cast<libbitcoin::message::compact_block::const_ptr const*>(block);
+}
+
 extern "C" {
 
 header_t compact_block_header(compact_block_t block) {
@@ -66,6 +79,15 @@ void compact_block_destruct(compact_block_t block) {
     delete &compact_block_cpp(block);
 }
 
+//Note: the returned block is read-only and it is owned by the handle, do not destruct it.
+compact_block_t compact_block_ptr_get(compact_block_ptr_t block) {
+    return const_cast<libbitcoin::message::compact_block*>(compact_block_ptr_const_cpp(block).get());
+}
+
+void compact_block_ptr_release(compact_block_ptr_t block) {
+    delete static_cast<libbitcoin::message::compact_block::const_ptr const*>(block);
+}
+
 void compact_block_reset(compact_block_t block) {
     compact_block_cpp(block).reset();
 }
@@ -22,6 +22,12 @@
 #include <bitprim/nodecint/convertions.hpp>
 #include <bitprim/nodecint/helpers.hpp>
 
+#include <algorithm>
+#include <cstring>
+
+//Note: the hashes are packed, the buffer functions copy the whole vector at once.
+static_assert(sizeof(libbitcoin::hash_digest) == BITCOIN_HASH_SIZE, "hash_digest must be packed");
+
 std::vector<libbitcoin::hash_digest> const& chain_hash_list_const_cpp(hash_list_t list) {
     return *static_cast<std::vector<libbitcoin::hash_digest> const*>(list);
 }
@@ -40,6 +46,14 @@ hash_list_t chain_hash_list_construct_default() {
     return new std::vector<libbitcoin::hash_digest>();
 }
 
+hash_list_t chain_hash_list_construct_from_buffer(uint8_t const* buffer, uint64_t /*size_t*/ count) {
+    auto* res = new std::vector<libbitcoin::hash_digest>(count);
+    if (count != 0) {
+        std::memcpy(res->data(), buffer, count * BITCOIN_HASH_SIZE);
+    }
+    return res;
+}
+
 void chain_hash_list_push_back(hash_list_t list, hash_t hash) {
     auto hash_cpp = bitprim::to_array(hash.hash);
     chain_hash_list_cpp(list).push_back(hash_cpp);
@@ -63,4 +77,13 @@ void chain_hash_list_nth_out(hash_list_t list, uint64_t /*size_t*/ n, hash_t* ou
     std::memcpy(out_hash->hash, x.data(), BITCOIN_HASH_SIZE);
 }
 
+uint64_t /*size_t*/ chain_hash_list_copy_to(hash_list_t list, uint8_t* buffer, uint64_t /*size_t*/ capacity) {
+    auto const& list_cpp = chain_hash_list_const_cpp(list);
+    auto const count = std::min<uint64_t>(capacity, list_cpp.size());
+    if (count != 0) {
+        std::memcpy(buffer, list_cpp.data(), count * BITCOIN_HASH_SIZE);
+    }
+    return count;
+}
+
 } /* extern "C" */
@@ -30,6 +30,17 @@ libbitcoin::message::header& chain_header_cpp(header_t header) {
     return *static_cast<libbitcoin::message::header*>(header);
 }
 
+header_ptr_t chain_header_ptr_construct_from_cpp(libbitcoin::message::header::const_ptr const& header) {
+    if ( ! header) {
+        return nullptr;
+    }
+    return new libbitcoin::message::header::const_ptr(header);
+}
+
+libbitcoin::message::header::const_ptr const& chain_header_ptr_const_cpp(header_ptr_t header) {
+    return *static_cast<libbitcoin::message::header::const_ptr const*>(header);
+}
+
 extern "C" {
 
 
@@ -94,6 +105,15 @@ void chain_header_destruct(header_t header) {
     delete &chain_header_cpp(header);
 }
 
+//Note: the returned header is read-only and it is owned by the handle, do not destruct it.
+header_t chain_header_ptr_get(header_ptr_t header) {
+    return const_cast<libbitcoin::message::header*>(chain_header_ptr_const_cpp(header).get());
+}
+
+void chain_header_ptr_release(header_ptr_t header) {
+    delete static_cast<libbitcoin::message::header::const_ptr const*>(header);
+}
+
 int chain_header_is_valid(header_t header) {
     return static_cast<int>(chain_header_const_cpp(header).is_valid());
 }
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/chain/history_cursor.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include <bitprim/nodecint/history_cursor.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::history_cursor& history_cursor_cpp(history_cursor_t cursor) {
+    return *static_cast<bitprim::nodecint::history_cursor*>(cursor);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+void chain_history_cursor_destruct(history_cursor_t cursor) {
+    delete &history_cursor_cpp(cursor);
+}
+
+uint64_t /*size_t*/ chain_history_cursor_count(history_cursor_t cursor) {
+    return history_cursor_cpp(cursor).count;
+}
+
+uint64_t /*size_t*/ chain_history_cursor_remaining(history_cursor_t cursor) {
+    return history_cursor_cpp(cursor).entries.size();
+}
+
+int /*bool*/ chain_history_cursor_next(history_cursor_t cursor, uint64_t /*size_t*/ page_size, history_compact_list_t* out_page) {
+    auto& entries = history_cursor_cpp(cursor).entries;
+
+    if (entries.empty() || page_size == 0) {
+        return 0;
+    }
+
+    auto const size = std::min<uint64_t>(page_size, entries.size());
+    auto const first = std::prev(entries.end(), size);
+
+    // The entries are reversed, the page is read from the end.
+    *out_page = new libbitcoin::chain::history_compact::list(std::make_move_iterator(entries.rbegin()), std::make_move_iterator(std::next(entries.rbegin(), size)));
+    entries.erase(first, entries.end());
+
+    //Note: reallocated once a quarter of it is left, so the memory goes down with the pages
+    //      without moving the remaining entries on every page
+    if (entries.size() <= entries.capacity() / 4) {
+        entries.shrink_to_fit();
+    }
+    return 1;
+}
+
+} /* extern "C" */
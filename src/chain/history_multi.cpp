@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/chain/history_multi.h>
+
+#include <bitprim/nodecint/history_multi.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::history_multi& history_multi_cpp(history_multi_t history) {
+    return *static_cast<bitprim::nodecint::history_multi*>(history);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+void chain_history_multi_destruct(history_multi_t history) {
+    delete &history_multi_cpp(history);
+}
+
+history_compact_list_t chain_history_multi_list(history_multi_t history) {
+    return &history_multi_cpp(history).entries;
+}
+
+uint32_t const* chain_history_multi_address_indexes(history_multi_t history) {
+    return history_multi_cpp(history).address_indexes.data();
+}
+
+uint64_t /*size_t*/ chain_history_multi_address_count(history_multi_t history) {
+    return history_multi_cpp(history).errors.size();
+}
+
+int chain_history_multi_error(history_multi_t history, uint64_t /*size_t*/ address_index) {
+    return history_multi_cpp(history).errors[address_index];
+}
+
+} /* extern "C" */
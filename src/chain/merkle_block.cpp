@@ -19,6 +19,7 @@
 
 #include <bitprim/nodecint/chain/merkle_block.h>
 
+#include <bitprim/nodecint/convertions.hpp>
 #include <bitprim/nodecint/helpers.hpp>
 #include <bitcoin/bitcoin/message/merkle_block.hpp>
 #include <bitcoin/bitcoin/message/transaction.hpp>
@@ -31,6 +32,17 @@ libbitcoin::message::merkle_block& chain_merkle_block_cpp(merkle_block_t block)
     return *static_cast<libbitcoin::message::merkle_block*>(block);
 }
 
+merkle_block_ptr_t chain_merkle_block_ptr_construct_from_cpp(libbitcoin::message::merkle_block::const_ptr const& block) {
+    if ( ! block) {
+        return nullptr;
+    }
+    return new libbitcoin::message::merkle_block::const_ptr(block);
+}
+
+libbitcoin::message::merkle_block::const_ptr const& chain_merkle_block_ptr_const_cpp(merkle_block_ptr_t block) {
+    return *static_cast<libbitcoin::message::merkle_block::const_ptr const*>(block);
+}
+
 extern "C" {
 
 
@@ -38,6 +50,15 @@ void chain_merkle_block_destruct(merkle_block_t block) {
     delete &chain_merkle_block_cpp(block);
 }
 
+//Note: the returned block is read-only and it is owned by the handle, do not destruct it.
+merkle_block_t chain_merkle_block_ptr_get(merkle_block_ptr_t block) {
+    return const_cast<libbitcoin::message::merkle_block*>(chain_merkle_block_ptr_const_cpp(block).get());
+}
+
+void chain_merkle_block_ptr_release(merkle_block_ptr_t block) {
+    delete static_cast<libbitcoin::message::merkle_block::const_ptr const*>(block);
+}
+
 //hash_t chain_merkle_block_hash_nth(merkle_block_t block, uint64_t /*size_t*/ n) {
 //    //precondition: n >=0 && n < hashes().size()
 //
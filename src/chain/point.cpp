@@ -56,5 +56,9 @@ uint64_t chain_point_get_checksum(point_t point) {
     return chain_point_const_cpp(point).checksum();
 }
 
+void chain_point_destruct(point_t point) {
+    delete static_cast<libbitcoin::chain::point*>(point);
+}
+
 } /* extern "C" */
 
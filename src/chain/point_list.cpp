@@ -18,6 +18,10 @@
  */
 
 #include <bitprim/nodecint/chain/point_list.h>
+
+#include <algorithm>
+#include <cstring>
+
 #include <bitcoin/bitcoin/chain/point.hpp>
 
 std::vector<libbitcoin::chain::point> const& point_list_const_cpp(point_list_t point_list) {
@@ -28,6 +32,21 @@ std::vector<libbitcoin::chain::point>& point_list_cpp(point_list_t point_list) {
     return *static_cast<std::vector<libbitcoin::chain::point>*>(point_list);
 }
 
+point_list_t point_list_construct_from_buffer(uint8_t const* buffer, uint64_t /*size_t*/ count) {
+    auto* res = new std::vector<libbitcoin::chain::point>();
+    res->reserve(count);
+
+    for (uint64_t i = 0; i < count; ++i, buffer += BITCOIN_POINT_SIZE) {
+        libbitcoin::hash_digest hash;
+        std::memcpy(hash.data(), buffer, BITCOIN_HASH_SIZE);
+
+        auto const* index = buffer + BITCOIN_HASH_SIZE;
+        res->emplace_back(hash, uint32_t(index[0]) | (uint32_t(index[1]) << 8) | (uint32_t(index[2]) << 16) | (uint32_t(index[3]) << 24));
+    }
+
+    return res;
+}
+
 point_t point_list_nth(point_list_t point_list, uint64_t /*size_t*/ n) {
     auto& point_n = point_list_cpp(point_list)[n];
     return &point_n;
@@ -39,4 +58,22 @@ uint64_t /*size_t*/ point_list_count(point_list_t point_list) {
 
 void point_list_destruct(point_list_t point_list) {
     delete &point_list_cpp(point_list);
-}
\ No newline at end of file
+}
+
+uint64_t /*size_t*/ point_list_copy_to(point_list_t point_list, uint8_t* buffer, uint64_t /*size_t*/ capacity) {
+    auto const& list_cpp = point_list_const_cpp(point_list);
+    auto const count = std::min<uint64_t>(capacity, list_cpp.size());
+
+    for (uint64_t i = 0; i < count; ++i, buffer += BITCOIN_POINT_SIZE) {
+        auto const& point = list_cpp[i];
+        std::memcpy(buffer, point.hash().data(), BITCOIN_HASH_SIZE);
+
+        auto* index = buffer + BITCOIN_HASH_SIZE;
+        index[0] = uint8_t(point.index());
+        index[1] = uint8_t(point.index() >> 8);
+        index[2] = uint8_t(point.index() >> 16);
+        index[3] = uint8_t(point.index() >> 24);
+    }
+
+    return count;
+}
@@ -24,6 +24,8 @@
 #include <bitprim/nodecint/chain/output_list.h>
 #include <bitprim/nodecint/chain/input_list.h>
 
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+
 libbitcoin::message::transaction const& chain_transaction_const_cpp(transaction_t transaction) {
     return *static_cast<libbitcoin::message::transaction const*>(transaction);
 }
@@ -32,6 +34,17 @@ libbitcoin::message::transaction& chain_transaction_cpp(transaction_t transactio
     return *static_cast<libbitcoin::message::transaction*>(transaction);
 }
 
+transaction_ptr_t chain_transaction_ptr_construct_from_cpp(libbitcoin::message::transaction::const_ptr const& transaction) {
+    if ( ! transaction) {
+        return nullptr;
+    }
+    return new libbitcoin::message::transaction::const_ptr(transaction);
+}
+
+libbitcoin::message::transaction::const_ptr const& chain_transaction_ptr_const_cpp(transaction_ptr_t transaction) {
+    return *static_cast<libbitcoin::message::transaction::const_ptr const*>(transaction);
+}
+
 
 extern "C" {
 
@@ -48,11 +61,31 @@ transaction_t chain_transaction_construct(uint32_t version, uint32_t locktime, i
                                                 chain_output_list_const_cpp(outputs));
 }
 
+transaction_t chain_transaction_factory_from_data(uint32_t version, uint8_t const* data, uint64_t /*size_t*/ n) {
+    auto source = libbitcoin::make_safe_deserializer(data, data + n);
+    auto* tx = new libbitcoin::message::transaction;
+
+    if ( ! tx->from_data(version, source) || ! source.is_exhausted()) {
+        delete tx;
+        return nullptr;
+    }
+    return tx;
+}
+
 void chain_transaction_destruct(transaction_t transaction) {
     auto transaction_cpp = static_cast<libbitcoin::message::transaction*>(transaction);
     delete transaction_cpp;
 }
 
+//Note: the returned transaction is read-only and it is owned by the handle, do not destruct it.
+transaction_t chain_transaction_ptr_get(transaction_ptr_t transaction) {
+    return const_cast<libbitcoin::message::transaction*>(chain_transaction_ptr_const_cpp(transaction).get());
+}
+
+void chain_transaction_ptr_release(transaction_ptr_t transaction) {
+    delete static_cast<libbitcoin::message::transaction::const_ptr const*>(transaction);
+}
+
 int /*bool*/ chain_transaction_is_valid(transaction_t transaction) {
     return static_cast<int>(chain_transaction_const_cpp(transaction).is_valid());
 }
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/chain/unspent_list.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <bitprim/nodecint/unspent_list.hpp>
+
+namespace bitprim { namespace nodecint {
+
+// Spend rows carry the checksum of the output point they spend instead of a value.
+unspent_list make_unspent_list(libbitcoin::chain::history_compact::list const& history) {
+    std::unordered_set<uint64_t> spent;
+    for (auto const& row : history) {
+        if (row.kind == libbitcoin::chain::point_kind::spend) {
+            spent.insert(row.previous_checksum);
+        }
+    }
+
+    unspent_list res;
+    res.balance = 0;
+
+    for (auto const& row : history) {
+        if (row.kind != libbitcoin::chain::point_kind::output || spent.count(row.point.checksum()) != 0) {
+            continue;
+        }
+
+        unspent_output_t output;
+        std::copy(row.point.hash().begin(), row.point.hash().end(), output.hash.hash);
+        output.index = row.point.index();
+        output.height = row.height;
+        output.value = row.value;
+
+        res.outputs.push_back(output);
+        res.balance += row.value;
+    }
+
+    std::stable_sort(res.outputs.begin(), res.outputs.end(), [](unspent_output_t const& a, unspent_output_t const& b) {
+        return a.height < b.height;
+    });
+
+    return res;
+}
+
+} // namespace nodecint
+} // namespace bitprim
+
+namespace {
+
+inline
+bitprim::nodecint::unspent_list const& unspent_list_const_cpp(unspent_list_t list) {
+    return *static_cast<bitprim::nodecint::unspent_list const*>(list);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+void chain_unspent_list_destruct(unspent_list_t list) {
+    delete &unspent_list_const_cpp(list);
+}
+
+uint64_t /*size_t*/ chain_unspent_list_count(unspent_list_t list) {
+    return unspent_list_const_cpp(list).outputs.size();
+}
+
+unspent_output_t const* chain_unspent_list_data(unspent_list_t list) {
+    return unspent_list_const_cpp(list).outputs.data();
+}
+
+unspent_output_t chain_unspent_list_nth(unspent_list_t list, uint64_t /*size_t*/ n) {
+    return unspent_list_const_cpp(list).outputs[n];
+}
+
+uint64_t chain_unspent_list_balance(unspent_list_t list) {
+    return unspent_list_const_cpp(list).balance;
+}
+
+} /* extern "C" */
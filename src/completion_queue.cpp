@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/completion_queue.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace bitprim { namespace nodecint {
+
+// The descriptor is signaled when the queue goes from empty to non-empty and
+// drained when it becomes empty again, both under the mutex, so it is
+// readable exactly while there are completions to pop.
+
+completion_queue::completion_queue()
+    : read_fd_(-1), write_fd_(-1)
+{
+#if defined(__linux__)
+    read_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    write_fd_ = read_fd_;
+#elif !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) == 0) {
+        for (auto fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        read_fd_ = fds[0];
+        write_fd_ = fds[1];
+    }
+#endif
+}
+
+completion_queue::~completion_queue() {
+#if !defined(_WIN32)
+    if (read_fd_ >= 0) {
+        close(read_fd_);
+    }
+
+    if (write_fd_ >= 0 && write_fd_ != read_fd_) {
+        close(write_fd_);
+    }
+#endif
+}
+
+int completion_queue::fd() const {
+    return read_fd_;
+}
+
+size_t completion_queue::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completions_.size();
+}
+
+void completion_queue::push(completion_t const& completion) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    completions_.push_back(completion);
+
+    if (completions_.size() == 1) {
+        signal();
+    }
+}
+
+size_t completion_queue::pop(completion_t* out_completions, size_t max) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto n = std::min(max, completions_.size());
+    auto last = std::next(completions_.begin(), n);
+    std::copy(completions_.begin(), last, out_completions);
+    completions_.erase(completions_.begin(), last);
+
+    if (n > 0 && completions_.empty()) {
+        drain();
+    }
+
+    return n;
+}
+
+void completion_queue::signal() {
+#if defined(__linux__)
+    if (write_fd_ >= 0) {
+        uint64_t one = 1;
+        auto res = write(write_fd_, &one, sizeof(one));
+        (void)res;
+    }
+#elif !defined(_WIN32)
+    if (write_fd_ >= 0) {
+        uint8_t one = 1;
+        auto res = write(write_fd_, &one, sizeof(one));
+        (void)res;
+    }
+#endif
+}
+
+void completion_queue::drain() {
+#if defined(__linux__)
+    if (read_fd_ >= 0) {
+        uint64_t value;
+        auto res = read(read_fd_, &value, sizeof(value));
+        (void)res;
+    }
+#elif !defined(_WIN32)
+    if (read_fd_ >= 0) {
+        uint8_t buffer[64];
+        while (read(read_fd_, buffer, sizeof(buffer)) > 0) {}
+    }
+#endif
+}
+
+} // namespace nodecint
+} // namespace bitprim
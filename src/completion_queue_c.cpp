@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/completion_queue.h>
+
+#include <bitprim/nodecint/completion_queue.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::completion_queue& completion_queue_cpp(completion_queue_t queue) {
+    return *static_cast<bitprim::nodecint::completion_queue*>(queue);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+completion_queue_t completion_queue_construct() {
+    return new bitprim::nodecint::completion_queue();
+}
+
+void completion_queue_destruct(completion_queue_t queue) {
+    delete &completion_queue_cpp(queue);
+}
+
+int completion_queue_fd(completion_queue_t queue) {
+    return completion_queue_cpp(queue).fd();
+}
+
+uint64_t /*size_t*/ completion_queue_pop(completion_queue_t queue, completion_t* out_completions, uint64_t /*size_t*/ max) {
+    return completion_queue_cpp(queue).pop(out_completions, max);
+}
+
+uint64_t /*size_t*/ completion_queue_count(completion_queue_t queue) {
+    return completion_queue_cpp(queue).size();
+}
+
+} /* extern "C" */
@@ -19,14 +19,26 @@
 
 #include <bitprim/nodecint/executor_c.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <memory>
+#include <string>
 #include <boost/iostreams/device/file_descriptor.hpp>
 #include <boost/thread/latch.hpp>
+#include <bitprim/nodecint/api_stats.hpp>
 #include <bitprim/nodecint/executor.hpp>
 #include <bitprim/nodecint/version.h>
+#include <bitprim/nodecint/worker_pool.hpp>
 #include <bitcoin/bitcoin/wallet/mnemonic.hpp>
 
+#if ! defined(_WIN32)
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 
 libbitcoin::node::configuration make_config(char const* path) {
     libbitcoin::node::configuration config(libbitcoin::config::settings::mainnet);
@@ -117,6 +129,10 @@ struct executor {
     std::ostream sout_;
     std::ostream serr_;
     bitprim::nodecint::executor actual;
+
+    // Runs the blocking lookups of the async chain API, see executor_get_chain.
+    std::shared_ptr<bitprim::nodecint::worker_pool> workers = std::make_shared<bitprim::nodecint::worker_pool>(0);
+    void const* registered_chain = nullptr;
 };
 
 executor_t executor_construct(char const* path, FILE* sout, FILE* serr) {
@@ -142,6 +158,13 @@ executor_t executor_construct_handles(char const* path, void* sout, void* serr)
 void executor_destruct(executor_t exec) {
 //    std::cout << "From C++: executor_destruct\n";
 //    printf("executor_destruct - exec: 0x%" PRIXPTR "\n", (uintptr_t)exec);
+
+    //Note: the jobs in flight use the chain, they complete before it is destroyed
+    if (exec->registered_chain != nullptr) {
+        bitprim::nodecint::unregister_worker_pool(exec->registered_chain);
+    }
+    exec->workers->stop();
+
     delete exec;
 }
 
@@ -212,7 +235,14 @@ int executor_stopped(executor_t exec) {
 }
 
 chain_t executor_get_chain(executor_t exec) {
-    return &(exec->actual.node().chain());
+    auto* chain = &(exec->actual.node().chain());
+
+    if (exec->registered_chain != chain) {
+        bitprim::nodecint::register_worker_pool(chain, exec->workers);
+        exec->registered_chain = chain;
+    }
+
+    return chain;
 }
 
 p2p_t executor_get_p2p(executor_t exec) {
@@ -223,5 +253,88 @@ char const* executor_version() {
     return BITPRIM_NODECINT_VERSION;
 }
 
+uint64_t /*size_t*/ executor_get_api_stats(executor_t /*exec*/, api_stats_t* out_stats, uint64_t /*size_t*/ capacity) {
+    auto const entries = bitprim::nodecint::api_stats_entries();
+    auto const count = std::min<uint64_t>(capacity, entries.size());
+
+    for (size_t i = 0; i < count; ++i) {
+        out_stats[i] = entries[i]->stats();
+    }
+
+    return entries.size();
+}
+
+int executor_dump_api_stats(executor_t /*exec*/, char const* path) {
+    auto const text = bitprim::nodecint::api_stats_prometheus();
+    auto const tmp_path = std::string(path) + ".tmp";
+
+    auto* file = std::fopen(tmp_path.c_str(), "wb");
+    if (file == nullptr) {
+        return 1;
+    }
+
+    auto const written = std::fwrite(text.data(), 1, text.size(), file);
+    auto const closed = std::fclose(file);
+
+    //Note: replaced at once, so scrapers never read a partial file
+    if (written != text.size() || closed != 0 || std::rename(tmp_path.c_str(), path) != 0) {
+        std::remove(tmp_path.c_str());
+        return 1;
+    }
+
+    return 0;
+}
+
+#if ! defined(_WIN32)
+
+int executor_send_api_stats(executor_t /*exec*/, char const* socket_path) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+
+    if (std::strlen(socket_path) >= sizeof(address.sun_path)) {
+        return 1;
+    }
+    std::strcpy(address.sun_path, socket_path);
+
+    auto const fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 1;
+    }
+
+#if defined(SO_NOSIGPIPE)
+    //Note: macOS has no MSG_NOSIGNAL, the socket option keeps a closed peer from raising SIGPIPE.
+    int const on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    int const send_flags = 0;
+#else
+    int const send_flags = MSG_NOSIGNAL;
+#endif
+
+    if (::connect(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return 1;
+    }
+
+    auto const text = bitprim::nodecint::api_stats_prometheus();
+    size_t sent = 0;
+
+    //Note: a peer gone away is an EPIPE error, not a SIGPIPE killing the host process.
+    while (sent < text.size()) {
+        auto const res = ::send(fd, text.data() + sent, text.size() - sent, send_flags);
+        if (res < 0 && errno == EINTR) {
+            continue;
+        }
+        if (res <= 0) {
+            break;
+        }
+        sent += res;
+    }
+
+    ::close(fd);
+    return sent == text.size() ? 0 : 1;
+}
+
+#endif /* ! defined(_WIN32) */
+
 
 } /* extern "C" */
@@ -0,0 +1,297 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/hex.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <bitprim/nodecint/hex.hpp>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BITPRIM_HEX_X86
+#include <immintrin.h>
+#endif
+
+namespace bitprim { namespace hex {
+
+namespace {
+
+char const digits[] = "0123456789abcdef";
+
+struct decode_table {
+    decode_table() {
+        std::fill(std::begin(values), std::end(values), invalid);
+        for (int i = 0; i < 10; ++i) {
+            values['0' + i] = static_cast<uint8_t>(i);
+        }
+        for (int i = 0; i < 6; ++i) {
+            values['a' + i] = static_cast<uint8_t>(10 + i);
+            values['A' + i] = static_cast<uint8_t>(10 + i);
+        }
+    }
+
+    static constexpr uint8_t invalid = 0xff;
+    uint8_t values[256];
+};
+
+//Note: std::fill takes it by reference, C++11 needs the definition
+constexpr uint8_t decode_table::invalid;
+
+decode_table const& table() {
+    static decode_table const instance;
+    return instance;
+}
+
+#ifdef BITPRIM_HEX_X86
+
+// Nibble values of 16 hex characters, all_valid is cleared if any of them is not an hex digit.
+__attribute__((target("ssse3")))
+__m128i nibbles_ssse3(__m128i chars, __m128i& all_valid) {
+    auto const lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    auto const is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    auto const is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    all_valid = _mm_and_si128(all_valid, _mm_or_si128(is_digit, is_alpha));
+
+    auto const digit_values = _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+    auto const alpha_values = _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+    return _mm_or_si128(digit_values, alpha_values);
+}
+
+__attribute__((target("ssse3")))
+bool decode_ssse3_impl(char const* hex, size_t n, uint8_t* out) {
+    auto all_valid = _mm_set1_epi8(-1);
+    auto const weights = _mm_set1_epi16(0x0110);    // high nibble * 16 + low nibble
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        auto const a = nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<__m128i const*>(hex + 2 * i)), all_valid);
+        auto const b = nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<__m128i const*>(hex + 2 * i + 16)), all_valid);
+        auto const bytes = _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+    }
+
+    if (_mm_movemask_epi8(all_valid) != 0xffff) {
+        return false;
+    }
+
+    return decode_scalar(hex + 2 * i, n - i, out + i);
+}
+
+__attribute__((target("ssse3")))
+void encode_ssse3_impl(uint8_t const* data, size_t n, char* out) {
+    auto const lut = _mm_loadu_si128(reinterpret_cast<__m128i const*>(digits));
+    auto const mask = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+        auto const high = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+        auto const low = _mm_shuffle_epi8(lut, _mm_and_si128(bytes, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+
+    encode_scalar(data + i, n - i, out + 2 * i);
+}
+
+__attribute__((target("avx2")))
+__m256i nibbles_avx2(__m256i chars, __m256i& all_valid) {
+    auto const lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+    auto const is_digit = _mm256_andnot_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('9')), _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)));
+    auto const is_alpha = _mm256_andnot_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('f')), _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)));
+    all_valid = _mm256_and_si256(all_valid, _mm256_or_si256(is_digit, is_alpha));
+
+    auto const digit_values = _mm256_and_si256(is_digit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0')));
+    auto const alpha_values = _mm256_and_si256(is_alpha, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)));
+    return _mm256_or_si256(digit_values, alpha_values);
+}
+
+__attribute__((target("avx2")))
+bool decode_avx2_impl(char const* hex, size_t n, uint8_t* out) {
+    auto all_valid = _mm256_set1_epi8(-1);
+    auto const weights = _mm256_set1_epi16(0x0110);  // high nibble * 16 + low nibble
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        auto const a = nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(hex + 2 * i)), all_valid);
+        auto const b = nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(hex + 2 * i + 32)), all_valid);
+        auto const packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights), _mm256_maddubs_epi16(b, weights));
+        // packus works per 128 bits lane: [a0 b0 a1 b1] -> [a0 a1 b0 b1]
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+
+    if (_mm256_movemask_epi8(all_valid) != -1) {
+        return false;
+    }
+
+    return decode_ssse3_impl(hex + 2 * i, n - i, out + i);
+}
+
+__attribute__((target("avx2")))
+void encode_avx2_impl(uint8_t const* data, size_t n, char* out) {
+    auto const lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(digits)));
+    auto const mask = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        auto const bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+        auto const high = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+        auto const low = _mm256_shuffle_epi8(lut, _mm256_and_si256(bytes, mask));
+        // unpack works per 128 bits lane: lo = [0..7 16..23], hi = [8..15 24..31]
+        auto const lo = _mm256_unpacklo_epi8(high, low);
+        auto const hi = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    encode_ssse3_impl(data + i, n - i, out + 2 * i);
+}
+
+#endif // BITPRIM_HEX_X86
+
+struct dispatch {
+    dispatch()
+        : decode(decode_scalar), encode(encode_scalar)
+    {
+        if (decode_avx2() != nullptr) {
+            decode = decode_avx2();
+            encode = encode_avx2();
+        } else if (decode_ssse3() != nullptr) {
+            decode = decode_ssse3();
+            encode = encode_ssse3();
+        }
+    }
+
+    decode_function decode;
+    encode_function encode;
+};
+
+dispatch const& best() {
+    static dispatch const instance;
+    return instance;
+}
+
+} /* end of anonymous namespace */
+
+bool decode_scalar(char const* hex, size_t n, uint8_t* out) {
+    auto const& values = table().values;
+    uint8_t invalid = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        auto const high = values[static_cast<uint8_t>(hex[2 * i])];
+        auto const low = values[static_cast<uint8_t>(hex[2 * i + 1])];
+        invalid |= (high | low) & 0xf0;
+        out[i] = static_cast<uint8_t>((high << 4) | (low & 0x0f));
+    }
+
+    return invalid == 0;
+}
+
+void encode_scalar(uint8_t const* data, size_t n, char* out) {
+    for (size_t i = 0; i < n; ++i) {
+        out[2 * i] = digits[data[i] >> 4];
+        out[2 * i + 1] = digits[data[i] & 0x0f];
+    }
+}
+
+#ifdef BITPRIM_HEX_X86
+
+decode_function decode_ssse3() {
+    return __builtin_cpu_supports("ssse3") ? decode_ssse3_impl : nullptr;
+}
+
+encode_function encode_ssse3() {
+    return __builtin_cpu_supports("ssse3") ? encode_ssse3_impl : nullptr;
+}
+
+decode_function decode_avx2() {
+    return __builtin_cpu_supports("avx2") ? decode_avx2_impl : nullptr;
+}
+
+encode_function encode_avx2() {
+    return __builtin_cpu_supports("avx2") ? encode_avx2_impl : nullptr;
+}
+
+#else
+
+decode_function decode_ssse3() {
+    return nullptr;
+}
+
+encode_function encode_ssse3() {
+    return nullptr;
+}
+
+decode_function decode_avx2() {
+    return nullptr;
+}
+
+encode_function encode_avx2() {
+    return nullptr;
+}
+
+#endif // BITPRIM_HEX_X86
+
+bool decode(char const* hex, size_t n, uint8_t* out) {
+    return best().decode(hex, n, out);
+}
+
+void encode(uint8_t const* data, size_t n, char* out) {
+    best().encode(data, n, out);
+}
+
+} // namespace hex
+} // namespace bitprim
+
+
+extern "C" {
+
+int /*bool*/ hex_decode(char const* hex, uint64_t /*size_t*/ hex_size, uint8_t* out_data) {
+    if (hex_size % 2 != 0) {
+        return 0;
+    }
+    return static_cast<int>(bitprim::hex::decode(hex, hex_size / 2, out_data));
+}
+
+void hex_encode(uint8_t const* data, uint64_t /*size_t*/ n, char* out_hex) {
+    bitprim::hex::encode(data, n, out_hex);
+    out_hex[2 * n] = '\0';
+}
+
+int /*bool*/ hex_to_hash(char const* hex, hash_t* out_hash) {
+    if (std::strlen(hex) != 2 * BITCOIN_HASH_SIZE) {
+        return 0;
+    }
+
+    if ( ! bitprim::hex::decode(hex, BITCOIN_HASH_SIZE, out_hash->hash)) {
+        return 0;
+    }
+
+    std::reverse(std::begin(out_hash->hash), std::end(out_hash->hash));
+    return 1;
+}
+
+void hash_to_hex(hash_t hash, char* out_hex) {
+    std::reverse(std::begin(hash.hash), std::end(hash.hash));
+    hex_encode(hash.hash, BITCOIN_HASH_SIZE, out_hex);
+}
+
+} /* extern "C" */
@@ -0,0 +1,440 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/history_cache.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+
+namespace bitprim { namespace nodecint {
+
+namespace {
+
+using libbitcoin::short_hash;
+
+struct short_hash_hasher {
+    size_t operator()(short_hash const& hash) const {
+        // The bytes are already uniformly distributed.
+        size_t res;
+        std::memcpy(&res, hash.data(), sizeof(res));
+        return res;
+    }
+};
+
+struct cache_key {
+    short_hash hash;
+    size_t limit;
+    size_t from_height;
+
+    bool operator==(cache_key const& x) const {
+        return hash == x.hash && limit == x.limit && from_height == x.from_height;
+    }
+};
+
+struct cache_key_hasher {
+    size_t operator()(cache_key const& key) const {
+        return short_hash_hasher()(key.hash) ^ (key.limit * 0x9e3779b97f4a7c15ull) ^ (key.from_height * 0xc2b2ae3d27d4eb4full);
+    }
+};
+
+// Approximation of the memory used by an entry, including the bookkeeping.
+size_t entry_size(libbitcoin::chain::history_compact::list const& history) {
+    return history.size() * sizeof(libbitcoin::chain::history_compact) + 192;
+}
+
+size_t unspent_size(unspent_list const& unspent) {
+    return unspent.outputs.size() * sizeof(unspent_output_t) + 64;
+}
+
+// Hashes of the addresses an output script pays to (P2PKH, P2SH and P2PK).
+void output_addresses(libbitcoin::chain::script const& script, std::vector<short_hash>& out) {
+    using pattern = libbitcoin::chain::script;
+    auto const& ops = script.operations();
+
+    if (ops.empty()) {
+        return;
+    }
+
+    if (pattern::is_pay_key_hash_pattern(ops)) {
+        out.push_back(libbitcoin::to_array<libbitcoin::short_hash_size>(ops[2].data()));
+    } else if (pattern::is_pay_script_hash_pattern(ops)) {
+        out.push_back(libbitcoin::to_array<libbitcoin::short_hash_size>(ops[1].data()));
+    } else if (pattern::is_pay_public_key_pattern(ops)) {
+        out.push_back(libbitcoin::bitcoin_short_hash(ops[0].data()));
+    }
+}
+
+// The addresses spent from are the ones of the previous outputs, which the validation caches in the points.
+// The input script only tells them for P2PKH and P2SH (a P2PK input has no key), its last push (the key
+// or the redeem script) is only used when the previous output is not cached.
+void input_addresses(libbitcoin::chain::input const& input, std::vector<short_hash>& out) {
+    auto const& previous = input.previous_output().validation.cache;
+    if (previous.is_valid()) {
+        output_addresses(previous.script(), out);
+        return;
+    }
+
+    auto const& ops = input.script().operations();
+    if ( ! ops.empty() && ! ops.back().data().empty()) {
+        out.push_back(libbitcoin::bitcoin_short_hash(ops.back().data()));
+    }
+}
+
+void transaction_addresses(libbitcoin::chain::transaction const& tx, std::vector<short_hash>& out) {
+    for (auto const& input : tx.inputs()) {
+        input_addresses(input, out);
+    }
+
+    for (auto const& output : tx.outputs()) {
+        output_addresses(output.script(), out);
+    }
+}
+
+void blocks_addresses(libbitcoin::block_const_ptr_list_const_ptr const& blocks, std::vector<short_hash>& out) {
+    if ( ! blocks) {
+        return;
+    }
+
+    for (auto const& block : *blocks) {
+        for (auto const& tx : block->transactions()) {
+            transaction_addresses(tx, out);
+        }
+    }
+}
+
+} /* end of anonymous namespace */
+
+// history_cache::store
+// ----------------------------------------------------------------------------
+
+class history_cache::store
+{
+public:
+    explicit store(size_t memory_budget)
+        : budget_(memory_budget)
+    {}
+
+    bool find(cache_key const& key, history_ptr& out_history) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto const it = entries_.find(key);
+        if (it == entries_.end()) {
+            ++misses_;
+            return false;
+        }
+
+        ++hits_;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        out_history = it->second->history;
+        return true;
+    }
+
+    bool find_unspent(cache_key const& key, unspent_ptr& out_unspent) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto const it = entries_.find(key);
+        if (it == entries_.end() || ! it->second->unspent) {
+            return false;
+        }
+
+        ++hits_;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        out_unspent = it->second->unspent;
+        return true;
+    }
+
+    // Registers a lookup of the address, returns the generation to pass to insert/attach_unspent/cancel.
+    uint64_t begin_fetch(short_hash const& hash) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& x = in_flight_[hash];
+        ++x.count;
+        return x.generation;
+    }
+
+    void cancel_fetch(short_hash const& hash, uint64_t generation) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        end_fetch(hash, generation);
+    }
+
+    // Attached to the history entry it was computed from, if it is still cached.
+    void attach_unspent(cache_key const& key, unspent_ptr unspent, uint64_t generation) {
+        auto const size = unspent_size(*unspent);
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto const valid = end_fetch(key.hash, generation);
+        auto const it = entries_.find(key);
+        if ( ! valid || it == entries_.end() || it->second->unspent) {
+            return;
+        }
+
+        it->second->unspent = std::move(unspent);
+        it->second->size += size;
+        usage_ += size;
+
+        while (usage_ > budget_) {
+            erase(std::prev(lru_.end()));
+            ++evictions_;
+        }
+    }
+
+    // Dropped if its address was invalidated since the fetch started, it may be stale.
+    void insert(cache_key const& key, history_ptr history, uint64_t generation) {
+        auto const size = entry_size(*history);
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if ( ! end_fetch(key.hash, generation) || size > budget_) {
+            return;
+        }
+
+        auto const existing = entries_.find(key);
+        if (existing != entries_.end()) {
+            erase(existing->second);
+        }
+
+        lru_.push_front(entry{key, std::move(history), nullptr, size});
+        entries_.emplace(key, lru_.begin());
+        by_address_[key.hash].push_back(lru_.begin());
+        usage_ += size;
+
+        while (usage_ > budget_) {
+            erase(std::prev(lru_.end()));
+            ++evictions_;
+        }
+    }
+
+    void invalidate(std::vector<short_hash> const& hashes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto const& hash : hashes) {
+            auto const fetching = in_flight_.find(hash);
+            if (fetching != in_flight_.end()) {
+                ++fetching->second.generation;
+            }
+
+            auto const found = by_address_.find(hash);
+            if (found == by_address_.end()) {
+                continue;
+            }
+
+            for (auto it : found->second) {
+                entries_.erase(it->key);
+                usage_ -= it->size;
+                lru_.erase(it);
+                ++invalidations_;
+            }
+            by_address_.erase(found);
+        }
+    }
+
+    history_cache_stats_t stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        history_cache_stats_t res;
+        res.hits = hits_;
+        res.misses = misses_;
+        res.evictions = evictions_;
+        res.invalidations = invalidations_;
+        res.entries = entries_.size();
+        res.memory_usage = usage_;
+        res.memory_budget = budget_;
+        return res;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& x : in_flight_) {
+            ++x.second.generation;
+        }
+
+        lru_.clear();
+        entries_.clear();
+        by_address_.clear();
+        usage_ = 0;
+    }
+
+private:
+    struct entry {
+        cache_key key;
+        history_ptr history;
+        unspent_ptr unspent;    // computed on demand
+        size_t size;
+    };
+
+    using lru_list = std::list<entry>;
+
+    // Lookups of an address in progress, the generation changes when the address is invalidated.
+    struct fetching {
+        size_t count = 0;
+        uint64_t generation = 0;
+    };
+
+    // Called with the mutex locked, returns false if the address was invalidated during the lookup.
+    bool end_fetch(short_hash const& hash, uint64_t generation) {
+        auto const it = in_flight_.find(hash);
+        if (it == in_flight_.end()) {
+            return false;
+        }
+
+        auto const valid = it->second.generation == generation;
+        if (--it->second.count == 0) {
+            in_flight_.erase(it);
+        }
+        return valid;
+    }
+
+    void erase(lru_list::iterator it) {
+        auto& same_address = by_address_[it->key.hash];
+        same_address.erase(std::find(same_address.begin(), same_address.end(), it));
+        if (same_address.empty()) {
+            by_address_.erase(it->key.hash);
+        }
+
+        entries_.erase(it->key);
+        usage_ -= it->size;
+        lru_.erase(it);
+    }
+
+    mutable std::mutex mutex_;
+    lru_list lru_;          // most recently used first
+    std::unordered_map<cache_key, lru_list::iterator, cache_key_hasher> entries_;
+    std::unordered_map<short_hash, std::vector<lru_list::iterator>, short_hash_hasher> by_address_;
+    std::unordered_map<short_hash, fetching, short_hash_hasher> in_flight_;
+
+    size_t const budget_;
+    size_t usage_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+    uint64_t invalidations_ = 0;
+};
+
+// history_cache
+// ----------------------------------------------------------------------------
+
+history_cache::history_cache(libbitcoin::blockchain::safe_chain& chain, size_t memory_budget)
+    : chain_(chain)
+    , store_(std::make_shared<store>(memory_budget))
+{
+    std::weak_ptr<store> weak_store = store_;
+
+    // The subscriptions end on the first notification after the cache is destructed.
+    chain_.subscribe_blockchain([weak_store](std::error_code const& ec, size_t /*fork_height*/, libbitcoin::block_const_ptr_list_const_ptr incoming, libbitcoin::block_const_ptr_list_const_ptr replaced_blocks) {
+        auto const cache_store = weak_store.lock();
+        if (ec || ! cache_store) {
+            return false;
+        }
+
+        // Every address touched by the incoming and the replaced branch.
+        std::vector<short_hash> hashes;
+        blocks_addresses(incoming, hashes);
+        blocks_addresses(replaced_blocks, hashes);
+        cache_store->invalidate(hashes);
+        return true;
+    });
+
+    chain_.subscribe_transaction([weak_store](std::error_code const& ec, libbitcoin::transaction_const_ptr tx) {
+        auto const cache_store = weak_store.lock();
+        if (ec || ! cache_store) {
+            return false;
+        }
+
+        std::vector<short_hash> hashes;
+        transaction_addresses(*tx, hashes);
+        cache_store->invalidate(hashes);
+        return true;
+    });
+}
+
+history_cache::~history_cache() = default;
+
+libbitcoin::blockchain::safe_chain& history_cache::chain() {
+    return chain_;
+}
+
+void history_cache::fetch_history(libbitcoin::wallet::payment_address const& address, size_t limit, size_t from_height, fetch_handler handler) {
+    cache_key const key{address.hash(), limit, from_height};
+
+    history_ptr cached;
+    if (store_->find(key, cached)) {
+        handler(libbitcoin::error::success, std::move(cached));
+        return;
+    }
+
+    auto const generation = store_->begin_fetch(key.hash);
+    auto cache_store = store_;
+
+    chain_.fetch_history(address, limit, from_height, [cache_store, key, generation, handler](std::error_code const& ec, libbitcoin::chain::history_compact::list history) {
+        if (ec) {
+            cache_store->cancel_fetch(key.hash, generation);
+            handler(ec, nullptr);
+            return;
+        }
+
+        auto const res = std::make_shared<libbitcoin::chain::history_compact::list const>(std::move(history));
+        cache_store->insert(key, res, generation);
+        handler(ec, res);
+    });
+}
+
+void history_cache::fetch_unspent(libbitcoin::wallet::payment_address const& address, unspent_handler handler) {
+    cache_key const key{address.hash(), 0, 0};
+
+    unspent_ptr cached;
+    if (store_->find_unspent(key, cached)) {
+        handler(libbitcoin::error::success, std::move(cached));
+        return;
+    }
+
+    auto const generation = store_->begin_fetch(key.hash);
+    auto cache_store = store_;
+
+    fetch_history(address, 0, 0, [cache_store, key, generation, handler](libbitcoin::code const& ec, history_ptr history) {
+        if (ec) {
+            cache_store->cancel_fetch(key.hash, generation);
+            handler(ec, nullptr);
+            return;
+        }
+
+        auto const res = std::make_shared<unspent_list const>(make_unspent_list(*history));
+        cache_store->attach_unspent(key, res, generation);
+        handler(ec, res);
+    });
+}
+
+history_cache_stats_t history_cache::stats() const {
+    return store_->stats();
+}
+
+void history_cache::clear() {
+    store_->clear();
+}
+
+} // namespace nodecint
+} // namespace bitprim
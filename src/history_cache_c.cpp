@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/history_cache.h>
+
+#include <boost/thread/latch.hpp>
+
+#include <bitprim/nodecint/history_cache.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::history_cache& history_cache_cpp(history_cache_t cache) {
+    return *static_cast<bitprim::nodecint::history_cache*>(cache);
+}
+
+inline
+libbitcoin::chain::history_compact::list* history_copy(bitprim::nodecint::history_cache::history_ptr const& history) {
+    if ( ! history) {
+        return new libbitcoin::chain::history_compact::list;
+    }
+    return new libbitcoin::chain::history_compact::list(*history);
+}
+
+inline
+bitprim::nodecint::unspent_list* unspent_copy(bitprim::nodecint::history_cache::unspent_ptr const& unspent) {
+    if ( ! unspent) {
+        return new bitprim::nodecint::unspent_list{{}, 0};
+    }
+    return new bitprim::nodecint::unspent_list(*unspent);
+}
+
+int get_unspent(history_cache_t cache, payment_address_t address, bitprim::nodecint::history_cache::unspent_ptr& out_unspent) {
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+
+    history_cache_cpp(cache).fetch_unspent(address_cpp, [&](std::error_code const& ec, bitprim::nodecint::history_cache::unspent_ptr unspent) {
+        out_unspent = std::move(unspent);
+
+        res = ec.value();
+        latch.count_down();
+    });
+
+    latch.count_down_and_wait();
+    return res;
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+history_cache_t history_cache_construct(chain_t chain, uint64_t /*size_t*/ memory_budget) {
+    return new bitprim::nodecint::history_cache(*static_cast<libbitcoin::blockchain::safe_chain*>(chain), memory_budget);
+}
+
+void history_cache_destruct(history_cache_t cache) {
+    delete &history_cache_cpp(cache);
+}
+
+//It is the user's responsibility to release the history returned in the callback
+void history_cache_fetch_history(history_cache_t cache, void* ctx, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_fetch_handler_t handler) {
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+    chain_t chain = &history_cache_cpp(cache).chain();
+
+    history_cache_cpp(cache).fetch_history(address_cpp, limit, from_height, [chain, ctx, handler](std::error_code const& ec, bitprim::nodecint::history_cache::history_ptr history) {
+        handler(chain, ctx, ec.value(), history_copy(history));
+    });
+}
+
+//It is the user's responsibility to release the history returned
+int history_cache_get_history(history_cache_t cache, payment_address_t address, uint64_t /*size_t*/ limit, uint64_t /*size_t*/ from_height, history_compact_list_t* out_history) {
+    boost::latch latch(2); //Note: workaround to fix an error on some versions of Boost.Threads
+    int res;
+
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+
+    history_cache_cpp(cache).fetch_history(address_cpp, limit, from_height, [&](std::error_code const& ec, bitprim::nodecint::history_cache::history_ptr history) {
+        *out_history = history_copy(history);
+
+        res = ec.value();
+        latch.count_down();
+    });
+
+    latch.count_down_and_wait();
+    return res;
+}
+
+//It is the user's responsibility to release the unspent outputs returned in the callback
+void history_cache_fetch_unspent_outputs(history_cache_t cache, void* ctx, payment_address_t address, unspent_fetch_handler_t handler) {
+    libbitcoin::wallet::payment_address const& address_cpp = *static_cast<const libbitcoin::wallet::payment_address*>(address);
+    chain_t chain = &history_cache_cpp(cache).chain();
+
+    history_cache_cpp(cache).fetch_unspent(address_cpp, [chain, ctx, handler](std::error_code const& ec, bitprim::nodecint::history_cache::unspent_ptr unspent) {
+        handler(chain, ctx, ec.value(), unspent_copy(unspent));
+    });
+}
+
+//It is the user's responsibility to release the unspent outputs returned
+int history_cache_get_unspent_outputs(history_cache_t cache, payment_address_t address, unspent_list_t* out_unspent) {
+    bitprim::nodecint::history_cache::unspent_ptr unspent;
+    auto const res = get_unspent(cache, address, unspent);
+    *out_unspent = unspent_copy(unspent);
+    return res;
+}
+
+int history_cache_get_balances(history_cache_t cache, payment_address_t const* addresses, uint64_t /*size_t*/ count, uint64_t* out_balances) {
+    int res = 0;
+
+    for (uint64_t i = 0; i < count; ++i) {
+        bitprim::nodecint::history_cache::unspent_ptr unspent;
+        auto const error = get_unspent(cache, addresses[i], unspent);
+        out_balances[i] = unspent ? unspent->balance : 0;
+
+        if (res == 0) {
+            res = error;
+        }
+    }
+
+    return res;
+}
+
+void history_cache_stats(history_cache_t cache, history_cache_stats_t* out_stats) {
+    *out_stats = history_cache_cpp(cache).stats();
+}
+
+void history_cache_clear(history_cache_t cache) {
+    history_cache_cpp(cache).clear();
+}
+
+} /* extern "C" */
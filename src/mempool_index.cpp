@@ -0,0 +1,333 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/mempool_index.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/bitcoin/message/version.hpp>
+
+namespace bitprim { namespace nodecint {
+
+namespace {
+
+using libbitcoin::hash_digest;
+
+struct hash_hasher {
+    size_t operator()(hash_digest const& hash) const {
+        // The bytes are already uniformly distributed.
+        size_t res;
+        std::memcpy(&res, hash.data(), sizeof(res));
+        return res;
+    }
+};
+
+inline
+double fee_rate(mempool_entry_t const& entry) {
+    return entry.size == 0 ? 0.0 : double(entry.fee) / entry.size;
+}
+
+// Highest fee rate first, the oldest first for the same rate.
+struct by_fee_rate {
+    bool operator()(mempool_entry_t const* a, mempool_entry_t const* b) const {
+        auto const rate_a = fee_rate(*a);
+        auto const rate_b = fee_rate(*b);
+        if (rate_a != rate_b) {
+            return rate_a > rate_b;
+        }
+        return a->sequence < b->sequence;
+    }
+};
+
+// The fee needs the previous outputs cached by the validation. The transactions of a block popped off the
+// store do not have them, those get no fee (the lowest rate) rather than a wrong one.
+uint64_t known_fee(libbitcoin::chain::transaction const& tx) {
+    for (auto const& input : tx.inputs()) {
+        if ( ! input.previous_output().validation.cache.is_valid()) {
+            return 0;
+        }
+    }
+    return tx.fees();
+}
+
+} /* end of anonymous namespace */
+
+// mempool_index::store
+// ----------------------------------------------------------------------------
+
+class mempool_index::store
+{
+public:
+    store(size_t change_history, size_t max_count)
+        : change_history_(change_history)
+        , max_count_(max_count)
+    {}
+
+    void add(libbitcoin::chain::transaction const& tx) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        insert(tx);
+        trim();
+    }
+
+    // The non-coinbase transactions of the replaced blocks go back to the pool, unless the incoming blocks
+    // mine them again. Confirming the incoming blocks afterwards drops the ones they conflict with.
+    void reorganize(libbitcoin::block_const_ptr_list const& incoming, libbitcoin::block_const_ptr_list const& replaced) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if ( ! replaced.empty()) {
+            std::unordered_set<hash_digest, hash_hasher> mined;
+            for (auto const& block : incoming) {
+                for (auto const& tx : block->transactions()) {
+                    mined.insert(tx.hash());
+                }
+            }
+
+            for (auto const& block : replaced) {
+                for (auto const& tx : block->transactions()) {
+                    if ( ! tx.is_coinbase() && mined.count(tx.hash()) == 0) {
+                        insert(tx);
+                    }
+                }
+            }
+        }
+
+        for (auto const& block : incoming) {
+            confirm(*block);
+        }
+
+        trim();
+    }
+
+    uint64_t sequence() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sequence_;
+    }
+
+    size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    mempool_entry_list snapshot(size_t count_limit, uint64_t minimum_fee) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        mempool_entry_list res;
+        res.sequence = sequence_;
+
+        auto const limit = count_limit == 0 ? entries_.size() : std::min(count_limit, entries_.size());
+        res.entries.reserve(limit);
+
+        for (auto const* entry : by_rate_) {
+            if (res.entries.size() == limit) {
+                break;
+            }
+            if (entry->fee >= minimum_fee) {
+                res.entries.push_back(*entry);
+            }
+        }
+
+        return res;
+    }
+
+    bool changes(uint64_t since_sequence, mempool_entry_list& out_changes) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto const oldest = changes_.empty() ? sequence_ + 1 : changes_.front().sequence;
+        if (since_sequence + 1 < oldest) {
+            return false;
+        }
+
+        out_changes.sequence = sequence_;
+        out_changes.entries.clear();
+
+        // The sequence numbers are consecutive, the first change to return is at a known offset.
+        auto const first = std::min<uint64_t>(since_sequence + 1 - oldest, changes_.size());
+        out_changes.entries.assign(changes_.begin() + first, changes_.end());
+        return true;
+    }
+
+private:
+    struct stored_entry {
+        mempool_entry_t entry;
+        std::vector<uint64_t> spent;    // checksums of the outputs spent
+    };
+
+    // Called with the mutex locked.
+    void insert(libbitcoin::chain::transaction const& tx) {
+        auto const hash = tx.hash();
+        if (entries_.count(hash) != 0) {
+            return;
+        }
+
+        mempool_entry_t entry;
+        std::copy(hash.begin(), hash.end(), entry.hash.hash);
+        entry.size = tx.serialized_size(libbitcoin::message::version::level::canonical);
+        entry.fee = known_fee(tx);
+        entry.sequence = ++sequence_;
+        entry.removed = 0;
+
+        auto& stored = entries_[hash];
+        stored.entry = entry;
+
+        for (auto const& input : tx.inputs()) {
+            auto const checksum = input.previous_output().checksum();
+            spenders_[checksum] = hash;
+            stored.spent.push_back(checksum);
+        }
+
+        by_rate_.insert(&stored.entry);
+        record(entry);
+    }
+
+    // The transactions of the block leave the pool, together with the ones spending the same outputs.
+    // Called with the mutex locked.
+    void confirm(libbitcoin::chain::block const& block) {
+        for (auto const& tx : block.transactions()) {
+            remove(tx.hash());
+
+            for (auto const& input : tx.inputs()) {
+                auto const spender = spenders_.find(input.previous_output().checksum());
+                if (spender != spenders_.end()) {
+                    remove(hash_digest(spender->second));
+                }
+            }
+        }
+    }
+
+    // Evicts the lowest fee rates while over the size cap, each eviction is a removal change.
+    // Called with the mutex locked.
+    void trim() {
+        while (max_count_ != 0 && entries_.size() > max_count_) {
+            auto const& lowest = (*by_rate_.rbegin())->hash.hash;
+            hash_digest hash;
+            std::copy(std::begin(lowest), std::end(lowest), hash.begin());
+            remove(hash);
+        }
+    }
+
+    // Called with the mutex locked.
+    void remove(hash_digest const& hash) {
+        auto const it = entries_.find(hash);
+        if (it == entries_.end()) {
+            return;
+        }
+
+        auto const& stored = it->second;
+        for (auto checksum : stored.spent) {
+            auto const spender = spenders_.find(checksum);
+            if (spender != spenders_.end() && spender->second == hash) {
+                spenders_.erase(spender);
+            }
+        }
+
+        by_rate_.erase(&stored.entry);
+
+        auto change = stored.entry;
+        change.sequence = ++sequence_;
+        change.removed = 1;
+
+        entries_.erase(it);
+        record(change);
+    }
+
+    // Called with the mutex locked.
+    void record(mempool_entry_t const& change) {
+        if (change_history_ == 0) {
+            return;
+        }
+
+        if (changes_.size() == change_history_) {
+            changes_.pop_front();
+        }
+        changes_.push_back(change);
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<hash_digest, stored_entry, hash_hasher> entries_;
+    std::unordered_map<uint64_t, hash_digest> spenders_;     // output checksum -> pool transaction
+    std::set<mempool_entry_t const*, by_fee_rate> by_rate_;
+    std::deque<mempool_entry_t> changes_;
+    size_t const change_history_;
+    size_t const max_count_;
+    uint64_t sequence_ = 0;
+};
+
+// mempool_index
+// ----------------------------------------------------------------------------
+
+mempool_index::mempool_index(libbitcoin::blockchain::safe_chain& chain, size_t change_history, size_t max_count)
+    : store_(std::make_shared<store>(change_history, max_count))
+{
+    std::weak_ptr<store> weak_store = store_;
+
+    // The subscriptions end on the first notification after the index is destructed.
+    chain.subscribe_transaction([weak_store](std::error_code const& ec, libbitcoin::transaction_const_ptr tx) {
+        auto const index_store = weak_store.lock();
+        if (ec || ! index_store) {
+            return false;
+        }
+
+        // The accepted transactions keep their previous outputs from validation, needed for the fee.
+        index_store->add(*tx);
+        return true;
+    });
+
+    chain.subscribe_blockchain([weak_store](std::error_code const& ec, size_t /*fork_height*/, libbitcoin::block_const_ptr_list_const_ptr incoming, libbitcoin::block_const_ptr_list_const_ptr replaced_blocks) {
+        auto const index_store = weak_store.lock();
+        if (ec || ! index_store) {
+            return false;
+        }
+
+        static libbitcoin::block_const_ptr_list const none;
+        index_store->reorganize(incoming ? *incoming : none, replaced_blocks ? *replaced_blocks : none);
+        return true;
+    });
+}
+
+mempool_index::~mempool_index() = default;
+
+uint64_t mempool_index::sequence() const {
+    return store_->sequence();
+}
+
+size_t mempool_index::count() const {
+    return store_->count();
+}
+
+mempool_entry_list mempool_index::snapshot(size_t count_limit, uint64_t minimum_fee) const {
+    return store_->snapshot(count_limit, minimum_fee);
+}
+
+bool mempool_index::changes(uint64_t since_sequence, mempool_entry_list& out_changes) const {
+    return store_->changes(since_sequence, out_changes);
+}
+
+} // namespace nodecint
+} // namespace bitprim
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/mempool_index.h>
+
+#include <utility>
+
+#include <bitprim/nodecint/mempool_index.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::mempool_index& mempool_index_cpp(mempool_index_t index) {
+    return *static_cast<bitprim::nodecint::mempool_index*>(index);
+}
+
+inline
+bitprim::nodecint::mempool_entry_list const& mempool_entry_list_const_cpp(mempool_entry_list_t list) {
+    return *static_cast<bitprim::nodecint::mempool_entry_list const*>(list);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+mempool_index_t mempool_index_construct(chain_t chain, uint64_t /*size_t*/ change_history, uint64_t /*size_t*/ max_count) {
+    return new bitprim::nodecint::mempool_index(*static_cast<libbitcoin::blockchain::safe_chain*>(chain), change_history, max_count);
+}
+
+void mempool_index_destruct(mempool_index_t index) {
+    delete &mempool_index_cpp(index);
+}
+
+uint64_t mempool_index_sequence(mempool_index_t index) {
+    return mempool_index_cpp(index).sequence();
+}
+
+uint64_t /*size_t*/ mempool_index_count(mempool_index_t index) {
+    return mempool_index_cpp(index).count();
+}
+
+//It is the user's responsibility to release the list returned
+mempool_entry_list_t mempool_index_snapshot(mempool_index_t index, uint64_t /*size_t*/ count_limit, uint64_t minimum_fee) {
+    return new bitprim::nodecint::mempool_entry_list(mempool_index_cpp(index).snapshot(count_limit, minimum_fee));
+}
+
+//It is the user's responsibility to release the list returned
+int /*bool*/ mempool_index_changes(mempool_index_t index, uint64_t since_sequence, mempool_entry_list_t* out_changes) {
+    bitprim::nodecint::mempool_entry_list changes;
+    if ( ! mempool_index_cpp(index).changes(since_sequence, changes)) {
+        return 0;
+    }
+
+    *out_changes = new bitprim::nodecint::mempool_entry_list(std::move(changes));
+    return 1;
+}
+
+void chain_mempool_entry_list_destruct(mempool_entry_list_t list) {
+    delete &mempool_entry_list_const_cpp(list);
+}
+
+uint64_t /*size_t*/ chain_mempool_entry_list_count(mempool_entry_list_t list) {
+    return mempool_entry_list_const_cpp(list).entries.size();
+}
+
+mempool_entry_t const* chain_mempool_entry_list_data(mempool_entry_list_t list) {
+    return mempool_entry_list_const_cpp(list).entries.data();
+}
+
+uint64_t chain_mempool_entry_list_sequence(mempool_entry_list_t list) {
+    return mempool_entry_list_const_cpp(list).sequence;
+}
+
+} /* extern "C" */
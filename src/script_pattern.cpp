@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/script_pattern.hpp>
+
+#include <cstring>
+
+#include <bitcoin/bitcoin/math/hash.hpp>
+
+namespace bitprim { namespace nodecint {
+
+namespace {
+
+// Output script opcodes, the scripts are matched on their serialization (without the length prefix).
+constexpr uint8_t op_1 = 0x51;
+constexpr uint8_t op_16 = 0x60;
+constexpr uint8_t op_return = 0x6a;
+constexpr uint8_t op_dup = 0x76;
+constexpr uint8_t op_equal = 0x87;
+constexpr uint8_t op_equalverify = 0x88;
+constexpr uint8_t op_hash160 = 0xa9;
+constexpr uint8_t op_checksig = 0xac;
+constexpr uint8_t op_checkmultisig = 0xae;
+
+inline
+bool is_public_key_size(size_t size) {
+    return size == 33 || size == 65;
+}
+
+// m <keys> n OP_CHECKMULTISIG, with 1 <= m <= n <= 16 and only public key pushes in between.
+bool is_pay_multisig(uint8_t const* script, size_t size) {
+    if (size < 3 || script[size - 1] != op_checkmultisig) {
+        return false;
+    }
+
+    auto const m = script[0];
+    auto const n = script[size - 2];
+    if (m < op_1 || m > op_16 || n < op_1 || n > op_16 || m > n) {
+        return false;
+    }
+
+    size_t keys = 0;
+    size_t i = 1;
+    while (i < size - 2) {
+        auto const push = script[i];
+        if ( ! is_public_key_size(push) || i + 1 + push > size - 2) {
+            return false;
+        }
+        i += 1 + push;
+        ++keys;
+    }
+
+    return keys == size_t(n - op_1 + 1);
+}
+
+} /* end of anonymous namespace */
+
+script_pattern_t classify_output_script(uint8_t const* script, size_t size, uint8_t* out_hash) {
+    if (size == 25 && script[0] == op_dup && script[1] == op_hash160 && script[2] == BITCOIN_SHORT_HASH_SIZE
+            && script[23] == op_equalverify && script[24] == op_checksig) {
+        std::memcpy(out_hash, script + 3, BITCOIN_SHORT_HASH_SIZE);
+        return script_pattern_pay_key_hash;
+    }
+
+    if (size == 23 && script[0] == op_hash160 && script[1] == BITCOIN_SHORT_HASH_SIZE && script[22] == op_equal) {
+        std::memcpy(out_hash, script + 2, BITCOIN_SHORT_HASH_SIZE);
+        return script_pattern_pay_script_hash;
+    }
+
+    if (size >= 2 && is_public_key_size(script[0]) && size == size_t(script[0]) + 2 && script[size - 1] == op_checksig) {
+        auto const hash = libbitcoin::bitcoin_short_hash(libbitcoin::data_slice(script + 1, script + 1 + script[0]));
+        std::memcpy(out_hash, hash.data(), BITCOIN_SHORT_HASH_SIZE);
+        return script_pattern_pay_public_key;
+    }
+
+    if (size >= 1 && script[0] == op_return) {
+        return script_pattern_null_data;
+    }
+
+    if (is_pay_multisig(script, size)) {
+        return script_pattern_pay_multisig;
+    }
+
+    return script_pattern_non_standard;
+}
+
+} // namespace nodecint
+} // namespace bitprim
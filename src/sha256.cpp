@@ -0,0 +1,451 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/sha256.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BITPRIM_SHA256_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace bitprim { namespace sha256 {
+
+namespace {
+
+uint32_t const initial_state[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+uint32_t const k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+// Second block of a 64 bytes message and the block of the second hash (32 bytes message), after their data.
+uint8_t const padding64[64] = {
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x00
+};
+
+uint8_t const padding32[32] = {
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x00
+};
+
+inline
+uint32_t read_be(uint8_t const* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+inline
+void write_be(uint8_t* p, uint32_t x) {
+    p[0] = uint8_t(x >> 24);
+    p[1] = uint8_t(x >> 16);
+    p[2] = uint8_t(x >> 8);
+    p[3] = uint8_t(x);
+}
+
+inline
+uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+using transform_function = void (*)(uint32_t* state, uint8_t const* blocks, size_t count);
+
+void transform_scalar(uint32_t* state, uint8_t const* blocks, size_t count) {
+    for (; count != 0; --count, blocks += 64) {
+        uint32_t w[64];
+        for (size_t t = 0; t < 16; ++t) {
+            w[t] = read_be(blocks + 4 * t);
+        }
+        for (size_t t = 16; t < 64; ++t) {
+            auto const s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            auto const s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        auto a = state[0], b = state[1], c = state[2], d = state[3];
+        auto e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (size_t t = 0; t < 64; ++t) {
+            auto const t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[t] + w[t];
+            auto const t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+// The padding of the n bytes message is added to its last partial block.
+void double_hash_with(transform_function transform, uint8_t const* data, size_t n, uint8_t* out) {
+    uint32_t state[8];
+    std::copy(std::begin(initial_state), std::end(initial_state), state);
+
+    auto const full = n / 64;
+    transform(state, data, full);
+
+    uint8_t tail[128] = {};
+    auto const rest = n % 64;
+    std::copy(data + full * 64, data + n, tail);
+    tail[rest] = 0x80;
+
+    auto const tail_size = rest < 56 ? 64 : 128;
+    auto const bits = uint64_t(n) * 8;
+    write_be(tail + tail_size - 8, uint32_t(bits >> 32));
+    write_be(tail + tail_size - 4, uint32_t(bits));
+    transform(state, tail, tail_size / 64);
+
+    uint8_t second[64];
+    for (size_t i = 0; i < 8; ++i) {
+        write_be(second + 4 * i, state[i]);
+    }
+    std::memcpy(second + 32, padding32, sizeof(padding32));
+
+    std::copy(std::begin(initial_state), std::end(initial_state), state);
+    transform(state, second, 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        write_be(out + 4 * i, state[i]);
+    }
+}
+
+void double_hash64_with(transform_function transform, uint8_t const* data, size_t count, uint8_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t state[8];
+        std::copy(std::begin(initial_state), std::end(initial_state), state);
+        transform(state, data + 64 * i, 1);
+        transform(state, padding64, 1);
+
+        uint8_t second[64];
+        for (size_t j = 0; j < 8; ++j) {
+            write_be(second + 4 * j, state[j]);
+        }
+        std::memcpy(second + 32, padding32, sizeof(padding32));
+
+        std::copy(std::begin(initial_state), std::end(initial_state), state);
+        transform(state, second, 1);
+
+        for (size_t j = 0; j < 8; ++j) {
+            write_be(out + 32 * i + 4 * j, state[j]);
+        }
+    }
+}
+
+#ifdef BITPRIM_SHA256_X86
+
+// Four rounds with the message words in msg, the state as ABEF/CDGH.
+#define BITPRIM_SHA256_ROUNDS(msg, i)                                                        \
+    tmp = _mm_add_epi32(msg, _mm_loadu_si128(reinterpret_cast<__m128i const*>(k + 4 * (i)))); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);                                      \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(tmp, 0x0e))
+
+// The next four message words from the previous sixteen (a oldest, d newest), stored in a.
+#define BITPRIM_SHA256_SCHEDULE(a, b, c, d) \
+    a = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(a, b), _mm_alignr_epi8(d, c, 4)), d)
+
+__attribute__((target("sha,sse4.1")))
+void transform_shani(uint32_t* state, uint8_t const* blocks, size_t count) {
+    auto const byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+
+    auto tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state)), 0xb1);      // CDAB
+    auto state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state + 4)), 0x1b); // EFGH
+    auto state0 = _mm_alignr_epi8(tmp, state1, 8);                                                       // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);                                                         // CDGH
+
+    for (; count != 0; --count, blocks += 64) {
+        auto const abef = state0;
+        auto const cdgh = state1;
+
+        auto msg0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks)), byte_swap);
+        auto msg1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks + 16)), byte_swap);
+        auto msg2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks + 32)), byte_swap);
+        auto msg3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks + 48)), byte_swap);
+
+        BITPRIM_SHA256_ROUNDS(msg0, 0);
+        BITPRIM_SHA256_ROUNDS(msg1, 1);
+        BITPRIM_SHA256_ROUNDS(msg2, 2);
+        BITPRIM_SHA256_ROUNDS(msg3, 3);
+
+        for (size_t i = 4; i < 16; i += 4) {
+            BITPRIM_SHA256_SCHEDULE(msg0, msg1, msg2, msg3);
+            BITPRIM_SHA256_ROUNDS(msg0, i);
+            BITPRIM_SHA256_SCHEDULE(msg1, msg2, msg3, msg0);
+            BITPRIM_SHA256_ROUNDS(msg1, i + 1);
+            BITPRIM_SHA256_SCHEDULE(msg2, msg3, msg0, msg1);
+            BITPRIM_SHA256_ROUNDS(msg2, i + 2);
+            BITPRIM_SHA256_SCHEDULE(msg3, msg0, msg1, msg2);
+            BITPRIM_SHA256_ROUNDS(msg3, i + 3);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);                 // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xb1);              // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);           // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);              // HGFE
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+
+#undef BITPRIM_SHA256_ROUNDS
+#undef BITPRIM_SHA256_SCHEDULE
+
+void double_hash_shani_impl(uint8_t const* data, size_t n, uint8_t* out) {
+    double_hash_with(transform_shani, data, n, out);
+}
+
+void double_hash64_shani_impl(uint8_t const* data, size_t count, uint8_t* out) {
+    double_hash64_with(transform_shani, data, count, out);
+}
+
+// 8 messages at once, lane i of each vector belongs to message i.
+
+__attribute__((target("avx2")))
+inline
+__m256i rotr8(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+__attribute__((target("avx2")))
+void transform_8way(__m256i* state, __m256i const* words) {
+    __m256i w[16];
+    std::copy(words, words + 16, w);
+
+    auto a = state[0], b = state[1], c = state[2], d = state[3];
+    auto e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (size_t t = 0; t < 64; ++t) {
+        if (t >= 16) {
+            auto const w15 = w[(t - 15) & 15];
+            auto const w2 = w[(t - 2) & 15];
+            auto const s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w15, 7), rotr8(w15, 18)), _mm256_srli_epi32(w15, 3));
+            auto const s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w2, 17), rotr8(w2, 19)), _mm256_srli_epi32(w2, 10));
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+        }
+
+        auto const sigma1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(e, 6), rotr8(e, 11)), rotr8(e, 25));
+        auto const choose = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+        auto const t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, sigma1), _mm256_add_epi32(choose, w[t & 15])), _mm256_set1_epi32(int(k[t])));
+
+        auto const sigma0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(a, 2), rotr8(a, 13)), rotr8(a, 22));
+        auto const majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        auto const t2 = _mm256_add_epi32(sigma0, majority);
+
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, t2);
+    }
+
+    state[0] = _mm256_add_epi32(state[0], a); state[1] = _mm256_add_epi32(state[1], b);
+    state[2] = _mm256_add_epi32(state[2], c); state[3] = _mm256_add_epi32(state[3], d);
+    state[4] = _mm256_add_epi32(state[4], e); state[5] = _mm256_add_epi32(state[5], f);
+    state[6] = _mm256_add_epi32(state[6], g); state[7] = _mm256_add_epi32(state[7], h);
+}
+
+__attribute__((target("avx2")))
+void initialize_8way(__m256i* state) {
+    for (size_t i = 0; i < 8; ++i) {
+        state[i] = _mm256_set1_epi32(int(initial_state[i]));
+    }
+}
+
+__attribute__((target("avx2")))
+void double_hash64_avx2_impl(uint8_t const* data, size_t count, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto const* inputs = data + 64 * i;
+
+        __m256i words[16];
+        for (size_t j = 0; j < 16; ++j) {
+            words[j] = _mm256_setr_epi32(
+                int(read_be(inputs + 4 * j)), int(read_be(inputs + 64 + 4 * j)),
+                int(read_be(inputs + 128 + 4 * j)), int(read_be(inputs + 192 + 4 * j)),
+                int(read_be(inputs + 256 + 4 * j)), int(read_be(inputs + 320 + 4 * j)),
+                int(read_be(inputs + 384 + 4 * j)), int(read_be(inputs + 448 + 4 * j)));
+        }
+
+        __m256i state[8];
+        initialize_8way(state);
+        transform_8way(state, words);
+
+        for (size_t j = 0; j < 16; ++j) {
+            words[j] = _mm256_set1_epi32(int(read_be(padding64 + 4 * j)));
+        }
+        transform_8way(state, words);
+
+        // The first digest is the message of the second hash.
+        for (size_t j = 0; j < 8; ++j) {
+            words[j] = state[j];
+            words[8 + j] = _mm256_set1_epi32(int(read_be(padding32 + 4 * j)));
+        }
+        initialize_8way(state);
+        transform_8way(state, words);
+
+        for (size_t j = 0; j < 8; ++j) {
+            alignas(32) uint32_t lanes[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), state[j]);
+            for (size_t lane = 0; lane < 8; ++lane) {
+                write_be(out + 32 * (i + lane) + 4 * j, lanes[lane]);
+            }
+        }
+    }
+
+    double_hash64_scalar(data + 64 * i, count - i, out + 32 * i);
+}
+
+bool cpu_supports_sha() {
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+}
+
+#endif // BITPRIM_SHA256_X86
+
+struct dispatch {
+    dispatch()
+        : hash(double_hash_scalar), hash64(double_hash64_scalar), name("scalar")
+    {
+        if (double_hash_shani() != nullptr) {
+            hash = double_hash_shani();
+            hash64 = double_hash64_shani();
+            name = "shani";
+        } else if (double_hash64_avx2() != nullptr) {
+            hash64 = double_hash64_avx2();
+            name = "avx2";
+        }
+    }
+
+    hash_function hash;
+    hash64_function hash64;
+    char const* name;
+};
+
+dispatch const& best() {
+    static dispatch const instance;
+    return instance;
+}
+
+} /* end of anonymous namespace */
+
+void double_hash_scalar(uint8_t const* data, size_t n, uint8_t* out) {
+    double_hash_with(transform_scalar, data, n, out);
+}
+
+void double_hash64_scalar(uint8_t const* data, size_t count, uint8_t* out) {
+    double_hash64_with(transform_scalar, data, count, out);
+}
+
+#ifdef BITPRIM_SHA256_X86
+
+hash_function double_hash_shani() {
+    return cpu_supports_sha() ? double_hash_shani_impl : nullptr;
+}
+
+hash64_function double_hash64_shani() {
+    return cpu_supports_sha() ? double_hash64_shani_impl : nullptr;
+}
+
+hash64_function double_hash64_avx2() {
+    return __builtin_cpu_supports("avx2") ? double_hash64_avx2_impl : nullptr;
+}
+
+#else
+
+hash_function double_hash_shani() {
+    return nullptr;
+}
+
+hash64_function double_hash64_shani() {
+    return nullptr;
+}
+
+hash64_function double_hash64_avx2() {
+    return nullptr;
+}
+
+#endif // BITPRIM_SHA256_X86
+
+char const* backend_name() {
+    return best().name;
+}
+
+void double_hash(uint8_t const* data, size_t n, uint8_t* out) {
+    best().hash(data, n, out);
+}
+
+void double_hash64(uint8_t const* data, size_t count, uint8_t* out) {
+    best().hash64(data, count, out);
+}
+
+void merkle_parents(digest const* hashes, size_t count, digest* out) {
+    auto const pairs = count / 2;
+    double_hash64(hashes->data(), pairs, out->data());
+
+    if (count % 2 != 0) {
+        uint8_t last[64];
+        std::memcpy(last, hashes[count - 1].data(), 32);
+        std::memcpy(last + 32, hashes[count - 1].data(), 32);
+        double_hash64(last, 1, out[pairs].data());
+    }
+}
+
+digest merkle_root(std::vector<digest> hashes) {
+    if (hashes.empty()) {
+        return digest{};
+    }
+
+    while (hashes.size() > 1) {
+        merkle_parents(hashes.data(), hashes.size(), hashes.data());
+        hashes.resize((hashes.size() + 1) / 2);
+    }
+
+    return hashes.front();
+}
+
+} // namespace sha256
+} // namespace bitprim
@@ -0,0 +1,365 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/stealth_index.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/stealth.hpp>
+#include <bitcoin/bitcoin/message/block.hpp>
+
+namespace bitprim { namespace nodecint {
+
+namespace {
+
+using libbitcoin::chain::stealth_compact;
+
+constexpr size_t bucket_bits = 16;
+constexpr size_t bucket_count = size_t(1) << bucket_bits;
+constexpr size_t scan_grain = 64;       // consecutive blocks taken by a worker at once
+
+struct stealth_row {
+    uint32_t key;
+    uint32_t height;
+    stealth_compact stealth;
+};
+
+inline
+bool operator<(stealth_row const& a, stealth_row const& b) {
+    return a.key != b.key ? a.key < b.key : a.height < b.height;
+}
+
+// The filters compare their bits with the little endian bytes of the prefix, most significant bit of
+// each byte first. Keyed in that order, the prefixes matching a filter are a contiguous range.
+inline
+uint32_t prefix_key(uint32_t prefix) {
+    return ((prefix & 0xff) << 24) | (((prefix >> 8) & 0xff) << 16) | (((prefix >> 16) & 0xff) << 8) | (prefix >> 24);
+}
+
+inline
+size_t bucket_of(uint32_t key) {
+    return key >> (32 - bucket_bits);
+}
+
+// Same pairing as the stealth table of the database: the output with the ephemeral key followed by the payment.
+void extract_rows(libbitcoin::chain::block const& block, size_t height, std::vector<stealth_row>& out) {
+    for (auto const& tx : block.transactions()) {
+        auto const& outputs = tx.outputs();
+
+        for (size_t i = 0; i + 1 < outputs.size(); ++i) {
+            auto const& script = outputs[i].script();
+
+            uint32_t prefix;
+            libbitcoin::hash_digest ephemeral_key;
+            if ( ! libbitcoin::to_stealth_prefix(prefix, script) || ! libbitcoin::extract_ephemeral_key(ephemeral_key, script)) {
+                continue;
+            }
+
+            auto const address = outputs[i + 1].address();
+            if ( ! address) {
+                continue;
+            }
+
+            out.push_back(stealth_row{prefix_key(prefix), static_cast<uint32_t>(height), stealth_compact{ephemeral_key, address.hash(), tx.hash()}});
+        }
+    }
+}
+
+} /* end of anonymous namespace */
+
+// stealth_index::store
+// ----------------------------------------------------------------------------
+
+class stealth_index::store
+{
+public:
+    store()
+        : buckets_(bucket_count)
+    {}
+
+    // The subscription indexes the blocks above top from now on, the scan the ones below.
+    bool begin_scan(size_t top) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (scan_top_ != unscanned) {
+            return false;
+        }
+
+        // Indexed by the subscription before, they are scanned again.
+        remove_if([top](stealth_row const& row) {
+            return row.height <= top;
+        });
+
+        scan_top_ = top;
+        return true;
+    }
+
+    void append_scanned(std::vector<stealth_row>& rows) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        scanned_.insert(scanned_.end(), std::make_move_iterator(rows.begin()), std::make_move_iterator(rows.end()));
+    }
+
+    // The scanned rows of the blocks replaced meanwhile are dropped, the subscription indexed their replacements.
+    // A failed scan leaves the store as before begin_scan, except for the rows it removed, so it can be run again.
+    void end_scan(bool succeeded) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (succeeded) {
+            for (auto& row : scanned_) {
+                if (row.height < reorganized_from_) {
+                    buckets_[bucket_of(row.key)].push_back(std::move(row));
+                    ++count_;
+                }
+            }
+
+            for (auto& bucket : buckets_) {
+                std::sort(bucket.begin(), bucket.end());
+            }
+
+            height_ = std::max(height_, scan_top_);
+            scanning_done_ = true;
+        } else {
+            scan_top_ = unscanned;
+            reorganized_from_ = unscanned;
+        }
+
+        scanned_.clear();
+        scanned_.shrink_to_fit();
+    }
+
+    void reorganize(size_t fork_height, libbitcoin::block_const_ptr_list const& incoming) {
+        std::vector<std::vector<stealth_row>> rows(incoming.size());
+        for (size_t i = 0; i < incoming.size(); ++i) {
+            extract_rows(*incoming[i], fork_height + 1 + i, rows[i]);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto const first = fork_height + 1;
+        remove_if([first](stealth_row const& row) {
+            return row.height >= first;
+        });
+
+        // The scan rows of the replaced blocks are dropped when it ends.
+        auto const scanning = scan_top_ != unscanned && ! scanning_done_;
+        if (scanning && first <= scan_top_) {
+            reorganized_from_ = std::min(reorganized_from_, first);
+        }
+
+        for (auto& block_rows : rows) {
+            for (auto& row : block_rows) {
+                auto& bucket = buckets_[bucket_of(row.key)];
+                bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), row), std::move(row));
+                ++count_;
+            }
+        }
+
+        height_ = fork_height + incoming.size();
+    }
+
+    size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+    size_t height() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return height_;
+    }
+
+    stealth_compact::list select(libbitcoin::binary const& filter, size_t from_height) const {
+        stealth_compact::list res;
+
+        // Longer than the prefix, nothing can match.
+        auto const bits = filter.size();
+        if (bits > 32) {
+            return res;
+        }
+
+        uint32_t value = 0;
+        auto const& blocks = filter.blocks();
+        for (size_t i = 0; i < std::min<size_t>(4, blocks.size()); ++i) {
+            value |= uint32_t(blocks[i]) << (24 - 8 * i);
+        }
+
+        auto const span = uint32_t((uint64_t(1) << (32 - bits)) - 1);
+        auto const low = value & ~span;
+        auto const high = low | span;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto b = bucket_of(low); b <= bucket_of(high); ++b) {
+            auto const& bucket = buckets_[b];
+            auto it = std::lower_bound(bucket.begin(), bucket.end(), low, [](stealth_row const& row, uint32_t key) {
+                return row.key < key;
+            });
+
+            for (; it != bucket.end() && it->key <= high; ++it) {
+                if (it->height >= from_height) {
+                    res.push_back(it->stealth);
+                }
+            }
+        }
+
+        return res;
+    }
+
+private:
+    static constexpr size_t unscanned = std::numeric_limits<size_t>::max();
+
+    // Called with the mutex locked.
+    template <typename Predicate>
+    void remove_if(Predicate predicate) {
+        for (auto& bucket : buckets_) {
+            auto const removed = std::remove_if(bucket.begin(), bucket.end(), predicate);
+            count_ -= std::distance(removed, bucket.end());
+            bucket.erase(removed, bucket.end());
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::vector<stealth_row>> buckets_;     // by the first bucket_bits of the key, sorted by key and height
+    std::vector<stealth_row> scanned_;                   // not visible until the scan ends
+    size_t count_ = 0;
+    size_t height_ = 0;
+    size_t scan_top_ = unscanned;
+    size_t reorganized_from_ = unscanned;
+    bool scanning_done_ = false;
+};
+
+constexpr size_t stealth_index::store::unscanned;
+
+// stealth_index
+// ----------------------------------------------------------------------------
+
+stealth_index::stealth_index(libbitcoin::blockchain::safe_chain& chain, size_t from_height)
+    : chain_(chain)
+    , from_height_(from_height)
+    , store_(std::make_shared<store>())
+{
+    std::weak_ptr<store> weak_store = store_;
+
+    // The subscription ends on the first notification after the index is destructed.
+    chain.subscribe_blockchain([weak_store](std::error_code const& ec, size_t fork_height, libbitcoin::block_const_ptr_list_const_ptr incoming, libbitcoin::block_const_ptr_list_const_ptr /*replaced_blocks*/) {
+        auto const index_store = weak_store.lock();
+        if (ec || ! index_store) {
+            return false;
+        }
+
+        if (incoming) {
+            index_store->reorganize(fork_height, *incoming);
+        }
+        return true;
+    });
+}
+
+stealth_index::~stealth_index() = default;
+
+// The block reads run on the calling thread, each worker takes the next scan_grain heights until the top.
+std::error_code stealth_index::build(size_t threads) {
+    std::error_code res;
+    size_t top;
+    chain_.fetch_last_height([&](std::error_code const& ec, size_t height) {
+        res = ec;
+        top = height;
+    });
+
+    if (res) {
+        return res;
+    }
+
+    if ( ! store_->begin_scan(top)) {
+        return libbitcoin::error::operation_failed;
+    }
+
+    std::atomic<size_t> next(from_height_);
+    std::atomic<bool> failed(false);
+    std::mutex error_mutex;
+
+    // The first failure stops every worker, the rest of the blocks would be scanned for nothing.
+    auto work = [&]() {
+        std::vector<stealth_row> rows;
+        size_t first;
+
+        while ( ! failed && (first = next.fetch_add(scan_grain)) <= top) {
+            auto const last = std::min(top, first + scan_grain - 1);
+
+            for (auto height = first; height <= last && ! failed; ++height) {
+                chain_.fetch_block(height, [&](std::error_code const& ec, libbitcoin::message::block::const_ptr block, size_t /*height*/) {
+                    if (ec) {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        res = ec;
+                        failed = true;
+                        return;
+                    }
+                    extract_rows(*block, height, rows);
+                });
+            }
+
+            if (failed) {
+                break;
+            }
+
+            store_->append_scanned(rows);
+            rows.clear();
+        }
+    };
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto const blocks = top >= from_height_ ? top - from_height_ + 1 : 0;
+    auto const workers = std::max<size_t>(1, std::min(threads, (blocks + scan_grain - 1) / scan_grain));
+
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < workers; ++i) {
+        pool.emplace_back(work);
+    }
+    work();
+
+    for (auto& worker : pool) {
+        worker.join();
+    }
+
+    store_->end_scan( ! res);
+    return res;
+}
+
+size_t stealth_index::count() const {
+    return store_->count();
+}
+
+size_t stealth_index::height() const {
+    return store_->height();
+}
+
+stealth_compact::list stealth_index::select(libbitcoin::binary const& filter, size_t from_height) const {
+    return store_->select(filter, from_height);
+}
+
+} // namespace nodecint
+} // namespace bitprim
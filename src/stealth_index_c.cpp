@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/stealth_index.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <bitprim/nodecint/stealth_index.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::stealth_index& stealth_index_cpp(stealth_index_t index) {
+    return *static_cast<bitprim::nodecint::stealth_index*>(index);
+}
+
+inline
+libbitcoin::binary const& filter_const_cpp(binary_t filter) {
+    return *static_cast<libbitcoin::binary const*>(filter);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+stealth_index_t stealth_index_construct(chain_t chain, uint64_t /*size_t*/ from_height) {
+    return new bitprim::nodecint::stealth_index(*static_cast<libbitcoin::blockchain::safe_chain*>(chain), from_height);
+}
+
+void stealth_index_destruct(stealth_index_t index) {
+    delete &stealth_index_cpp(index);
+}
+
+int stealth_index_build(stealth_index_t index, uint64_t /*size_t*/ threads) {
+    return stealth_index_cpp(index).build(threads).value();
+}
+
+uint64_t /*size_t*/ stealth_index_count(stealth_index_t index) {
+    return stealth_index_cpp(index).count();
+}
+
+uint64_t /*size_t*/ stealth_index_height(stealth_index_t index) {
+    return stealth_index_cpp(index).height();
+}
+
+void stealth_index_fetch(stealth_index_t index, void* ctx, binary_t filter, uint64_t from_height, uint64_t /*size_t*/ chunk_size, stealth_chunk_handler_t handler) {
+    auto rows = stealth_index_cpp(index).select(filter_const_cpp(filter), from_height);
+    chunk_size = std::max<uint64_t>(chunk_size, 1);
+
+    // A single chunk buffer, reused for every call.
+    libbitcoin::chain::stealth_compact::list chunk;
+    chunk.reserve(std::min<size_t>(chunk_size, rows.size()));
+
+    auto it = rows.begin();
+    do {
+        auto const last = std::next(it, std::min<size_t>(chunk_size, std::distance(it, rows.end())));
+        chunk.assign(std::make_move_iterator(it), std::make_move_iterator(last));
+        it = last;
+
+        auto const is_last = it == rows.end();
+        if (handler(index, ctx, 0, &chunk, static_cast<int>(is_last)) == 0) {
+            break;
+        }
+    } while (it != rows.end());
+}
+
+//It is the user's responsibility to release the list returned
+stealth_compact_list_t stealth_index_get(stealth_index_t index, binary_t filter, uint64_t from_height) {
+    return new libbitcoin::chain::stealth_compact::list(stealth_index_cpp(index).select(filter_const_cpp(filter), from_height));
+}
+
+} /* extern "C" */
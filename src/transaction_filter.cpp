@@ -0,0 +1,369 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/transaction_filter.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace bitprim { namespace nodecint {
+
+namespace {
+
+using libbitcoin::hash_digest;
+
+inline
+uint64_t word(hash_digest const& hash, size_t index) {
+    uint64_t res;
+    std::memcpy(&res, hash.data() + index * sizeof(res), sizeof(res));
+    return res;
+}
+
+struct hash_hasher {
+    size_t operator()(hash_digest const& hash) const {
+        // The bytes are already uniformly distributed.
+        return word(hash, 0);
+    }
+};
+
+struct point_key {
+    hash_digest hash;
+    uint32_t index;
+
+    bool operator==(point_key const& x) const {
+        return index == x.index && hash == x.hash;
+    }
+};
+
+struct point_hasher {
+    size_t operator()(point_key const& key) const {
+        return word(key.hash, 0) ^ (key.index * 0x9e3779b97f4a7c15ull);
+    }
+};
+
+// Two independent 64 bit values of the key, combined as h1 + i * h2 for each probe.
+struct bloom_key {
+    uint64_t h1;
+    uint64_t h2;
+};
+
+inline
+bloom_key script_bloom_key(hash_digest const& hash) {
+    return {word(hash, 0), word(hash, 1) | 1};
+}
+
+inline
+bloom_key point_bloom_key(hash_digest const& hash, uint32_t index) {
+    return {word(hash, 0) ^ (index * 0x9e3779b97f4a7c15ull), word(hash, 1) | 1};
+}
+
+class bloom_filter {
+public:
+    static constexpr size_t bits_per_entry = 10;
+    static constexpr size_t probes = 7;         // ~1% false positives at full capacity
+
+    explicit bloom_filter(size_t capacity)
+        : capacity_(capacity)
+        , words_((capacity * bits_per_entry + 63) / 64)
+    {}
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    void add(bloom_key key) {
+        auto const bits = words_.size() * 64;
+        for (size_t i = 0; i < probes; ++i) {
+            auto const bit = (key.h1 + i * key.h2) % bits;
+            words_[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    bool may_contain(bloom_key key) const {
+        auto const bits = words_.size() * 64;
+        for (size_t i = 0; i < probes; ++i) {
+            auto const bit = (key.h1 + i * key.h2) % bits;
+            if ((words_[bit / 64] & (uint64_t(1) << (bit % 64))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    size_t capacity_;
+    std::vector<uint64_t> words_;
+};
+
+} /* end of anonymous namespace */
+
+// transaction_filter::sets
+// ----------------------------------------------------------------------------
+
+class transaction_filter::sets
+{
+public:
+    static constexpr size_t initial_capacity = 1024;
+
+    void add_script(hash_digest const& hash) {
+        if (scripts_.insert(hash).second) {
+            added(script_bloom_key(hash));
+        }
+    }
+
+    void add_point(point_key const& key) {
+        if (points_.insert(key).second) {
+            added(point_bloom_key(key.hash, key.index));
+        }
+    }
+
+    size_t count() const {
+        return scripts_.size() + points_.size();
+    }
+
+    bool matches(libbitcoin::chain::transaction const& tx) const {
+        if ( ! points_.empty()) {
+            for (auto const& input : tx.inputs()) {
+                auto const& previous = input.previous_output();
+                if (bloom_.may_contain(point_bloom_key(previous.hash(), previous.index()))
+                    && points_.count(point_key{previous.hash(), previous.index()}) != 0) {
+                    return true;
+                }
+            }
+        }
+
+        if ( ! scripts_.empty()) {
+            for (auto const& output : tx.outputs()) {
+                auto const hash = script_hash(output.script());
+                if (bloom_.may_contain(script_bloom_key(hash)) && scripts_.count(hash) != 0) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+private:
+    // The bloom filter doubles its capacity when full, rebuilt from the exact sets.
+    void added(bloom_key key) {
+        if (count() <= bloom_.capacity()) {
+            bloom_.add(key);
+            return;
+        }
+
+        bloom_filter grown(bloom_.capacity() * 2);
+        for (auto const& hash : scripts_) {
+            grown.add(script_bloom_key(hash));
+        }
+        for (auto const& point : points_) {
+            grown.add(point_bloom_key(point.hash, point.index));
+        }
+        bloom_ = std::move(grown);
+    }
+
+    std::unordered_set<hash_digest, hash_hasher> scripts_;
+    std::unordered_set<point_key, point_hasher> points_;
+    bloom_filter bloom_{initial_capacity};
+};
+
+// transaction_filter
+// ----------------------------------------------------------------------------
+
+transaction_filter::transaction_filter()
+    : sets_(new sets)
+{}
+
+transaction_filter::~transaction_filter() = default;
+transaction_filter::transaction_filter(transaction_filter&&) = default;
+transaction_filter& transaction_filter::operator=(transaction_filter&&) = default;
+
+// static
+hash_digest transaction_filter::script_hash(libbitcoin::chain::script const& script) {
+    return libbitcoin::sha256_hash(script.to_data(false));
+}
+
+void transaction_filter::add_script_hash(hash_digest const& hash) {
+    sets_->add_script(hash);
+}
+
+void transaction_filter::add_script(libbitcoin::chain::script const& script) {
+    sets_->add_script(script_hash(script));
+}
+
+void transaction_filter::add_address(libbitcoin::wallet::payment_address const& address) {
+    using libbitcoin::wallet::payment_address;
+
+    auto const version = address.version();
+    auto const p2sh = version == payment_address::mainnet_p2sh || version == payment_address::testnet_p2sh;
+
+    libbitcoin::chain::script const script(p2sh
+        ? libbitcoin::chain::script::to_pay_script_hash_pattern(address.hash())
+        : libbitcoin::chain::script::to_pay_key_hash_pattern(address.hash()));
+
+    add_script(script);
+}
+
+void transaction_filter::add_output_point(libbitcoin::chain::output_point const& point) {
+    sets_->add_point(point_key{point.hash(), point.index()});
+}
+
+size_t transaction_filter::count() const {
+    return sets_->count();
+}
+
+bool transaction_filter::matches(libbitcoin::chain::transaction const& tx) const {
+    return sets_->matches(tx);
+}
+
+// transaction_subscription::state
+// ----------------------------------------------------------------------------
+
+class transaction_subscription::state
+{
+public:
+    state(transaction_filter filter, handler notify)
+        : filter_(std::make_shared<transaction_filter const>(std::move(filter)))
+        , notify_(std::move(notify))
+    {}
+
+    bool notify(std::error_code const& ec, libbitcoin::transaction_const_ptr const& tx) {
+        //Note: tx is null when the subscription is stopped.
+        if (ec || ! tx) {
+            return call(ec, tx);
+        }
+
+        ++seen_;
+
+        auto const filter = std::atomic_load(&filter_);
+        if ( ! filter->matches(*tx)) {
+            return ! stopped();
+        }
+
+        ++matched_;
+        return call(ec, tx);
+    }
+
+    // Waits for the handler calls in progress, the handler is not called after it returns.
+    // Called from the handler itself, it does not wait for that call.
+    void stop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stopped_ = true;
+
+        size_t const own = current_notify == this ? 1 : 0;
+        idle_.wait(lock, [this, own] {
+            return calls_ == own;
+        });
+    }
+
+    void replace_filter(transaction_filter filter) {
+        std::atomic_store(&filter_, std::make_shared<transaction_filter const>(std::move(filter)));
+    }
+
+    uint64_t seen() const {
+        return seen_;
+    }
+
+    uint64_t matched() const {
+        return matched_;
+    }
+
+private:
+    bool stopped() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stopped_;
+    }
+
+    bool call(std::error_code const& ec, libbitcoin::transaction_const_ptr const& tx) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_) {
+                return false;
+            }
+            ++calls_;
+        }
+
+        auto const previous = current_notify;
+        current_notify = this;
+        auto const res = notify_(ec, tx);
+        current_notify = previous;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--calls_ == 0) {
+            idle_.notify_all();
+        }
+        return res && ! stopped_;
+    }
+
+    // The state whose handler runs on this thread, to let the handler destruct its own subscription.
+    static thread_local state const* current_notify;
+
+    std::shared_ptr<transaction_filter const> filter_;      // accessed with atomic_load/atomic_store only
+    handler const notify_;
+    mutable std::mutex mutex_;
+    std::condition_variable idle_;
+    size_t calls_ = 0;
+    bool stopped_ = false;
+    std::atomic<uint64_t> seen_{0};
+    std::atomic<uint64_t> matched_{0};
+};
+
+thread_local transaction_subscription::state const* transaction_subscription::state::current_notify = nullptr;
+
+// transaction_subscription
+// ----------------------------------------------------------------------------
+
+transaction_subscription::transaction_subscription(libbitcoin::blockchain::safe_chain& chain, transaction_filter filter, handler notify)
+    : state_(std::make_shared<state>(std::move(filter), std::move(notify)))
+{
+    std::weak_ptr<state> weak_state = state_;
+
+    // The subscription ends on the first notification after this object is destructed.
+    chain.subscribe_transaction([weak_state](std::error_code const& ec, libbitcoin::transaction_const_ptr tx) {
+        auto const subscription_state = weak_state.lock();
+        if ( ! subscription_state) {
+            return false;
+        }
+        return subscription_state->notify(ec, tx);
+    });
+}
+
+transaction_subscription::~transaction_subscription() {
+    state_->stop();
+}
+
+void transaction_subscription::replace_filter(transaction_filter filter) {
+    state_->replace_filter(std::move(filter));
+}
+
+uint64_t transaction_subscription::seen() const {
+    return state_->seen();
+}
+
+uint64_t transaction_subscription::matched() const {
+    return state_->matched();
+}
+
+} // namespace nodecint
+} // namespace bitprim
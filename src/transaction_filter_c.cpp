@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/transaction_filter.h>
+
+#include <memory>
+#include <utility>
+
+#include <bitprim/nodecint/convertions.hpp>
+#include <bitprim/nodecint/helpers.hpp>
+#include <bitprim/nodecint/transaction_filter.hpp>
+
+namespace {
+
+inline
+bitprim::nodecint::transaction_filter& transaction_filter_cpp(transaction_filter_t filter) {
+    return *static_cast<bitprim::nodecint::transaction_filter*>(filter);
+}
+
+inline
+bitprim::nodecint::transaction_subscription& transaction_subscription_cpp(transaction_subscription_t subscription) {
+    return *static_cast<bitprim::nodecint::transaction_subscription*>(subscription);
+}
+
+// Takes the ownership of the handle.
+bitprim::nodecint::transaction_filter release_filter(transaction_filter_t filter) {
+    std::unique_ptr<bitprim::nodecint::transaction_filter> owned(&transaction_filter_cpp(filter));
+    return std::move(*owned);
+}
+
+} /* end of anonymous namespace */
+
+extern "C" {
+
+transaction_filter_t transaction_filter_construct() {
+    return new bitprim::nodecint::transaction_filter;
+}
+
+void transaction_filter_destruct(transaction_filter_t filter) {
+    delete &transaction_filter_cpp(filter);
+}
+
+void transaction_filter_add_script_hash(transaction_filter_t filter, hash_t script_hash) {
+    transaction_filter_cpp(filter).add_script_hash(bitprim::to_array(script_hash.hash));
+}
+
+void transaction_filter_add_script(transaction_filter_t filter, script_t script) {
+    transaction_filter_cpp(filter).add_script(chain_script_const_cpp(script));
+}
+
+void transaction_filter_add_address(transaction_filter_t filter, payment_address_t address) {
+    auto const& address_cpp = *static_cast<libbitcoin::wallet::payment_address const*>(address);
+    transaction_filter_cpp(filter).add_address(address_cpp);
+}
+
+void transaction_filter_add_output_point(transaction_filter_t filter, hash_t hash, uint32_t index) {
+    transaction_filter_cpp(filter).add_output_point(libbitcoin::chain::output_point(bitprim::to_array(hash.hash), index));
+}
+
+uint64_t /*size_t*/ transaction_filter_count(transaction_filter_t filter) {
+    return transaction_filter_cpp(filter).count();
+}
+
+int /*bool*/ transaction_filter_matches(transaction_filter_t filter, transaction_t transaction) {
+    return static_cast<int>(transaction_filter_cpp(filter).matches(chain_transaction_const_cpp(transaction)));
+}
+
+transaction_subscription_t chain_subscribe_transaction_filtered(executor_t exec, chain_t chain, void* ctx, transaction_filter_t filter, subscribe_transaction_handler_t handler) {
+    auto& chain_cpp = *static_cast<libbitcoin::blockchain::safe_chain*>(chain);
+
+    return new bitprim::nodecint::transaction_subscription(chain_cpp, release_filter(filter), [exec, chain, ctx, handler](std::error_code const& ec, libbitcoin::transaction_const_ptr tx) {
+        //Note: only the matching transactions are copied.
+        auto new_tx = tx ? new libbitcoin::message::transaction(*tx) : nullptr;
+        return handler(exec, chain, ctx, ec.value(), new_tx) != 0;
+    });
+}
+
+void chain_transaction_subscription_replace_filter(transaction_subscription_t subscription, transaction_filter_t filter) {
+    transaction_subscription_cpp(subscription).replace_filter(release_filter(filter));
+}
+
+void chain_transaction_subscription_destruct(transaction_subscription_t subscription) {
+    delete &transaction_subscription_cpp(subscription);
+}
+
+uint64_t chain_transaction_subscription_seen(transaction_subscription_t subscription) {
+    return transaction_subscription_cpp(subscription).seen();
+}
+
+uint64_t chain_transaction_subscription_matched(transaction_subscription_t subscription) {
+    return transaction_subscription_cpp(subscription).matched();
+}
+
+} /* extern "C" */
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitprim/nodecint/worker_pool.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace bitprim { namespace nodecint {
+
+namespace {
+
+struct registry {
+    std::mutex mutex;
+    std::unordered_map<void const*, std::shared_ptr<worker_pool>> pools;
+};
+
+registry& pool_registry() {
+    static registry instance;
+    return instance;
+}
+
+} /* end of anonymous namespace */
+
+worker_pool::worker_pool(size_t threads)
+    : size_(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency()))
+{}
+
+worker_pool::~worker_pool() {
+    stop();
+}
+
+bool worker_pool::post(job work) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return false;
+        }
+
+        jobs_.push_back(std::move(work));
+
+        if (threads_.empty()) {
+            threads_.reserve(size_);
+            for (size_t i = 0; i < size_; ++i) {
+                threads_.emplace_back([this] { run(); });
+            }
+        }
+    }
+
+    condition_.notify_one();
+    return true;
+}
+
+void worker_pool::stop() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        threads.swap(threads_);
+    }
+
+    condition_.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+size_t worker_pool::size() const {
+    return size_;
+}
+
+void worker_pool::run() {
+    while (true) {
+        job work;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return stopped_ || ! jobs_.empty(); });
+
+            if (jobs_.empty()) {
+                return;
+            }
+
+            work = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        work();
+    }
+}
+
+void register_worker_pool(void const* chain, std::shared_ptr<worker_pool> pool) {
+    auto& reg = pool_registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.pools[chain] = std::move(pool);
+}
+
+void unregister_worker_pool(void const* chain) {
+    auto& reg = pool_registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.pools.erase(chain);
+}
+
+std::shared_ptr<worker_pool> find_worker_pool(void const* chain) {
+    auto& reg = pool_registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto const it = reg.pools.find(chain);
+    return it != reg.pools.end() ? it->second : nullptr;
+}
+
+void post_or_run(void const* chain, worker_pool::job work) {
+    auto const pool = find_worker_pool(chain);
+    if (pool && pool->post(work)) {
+        return;
+    }
+
+    work();
+}
+
+} // namespace nodecint
+} // namespace bitprim
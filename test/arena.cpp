@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <bitprim/nodecint/arena.hpp>
+
+using bitprim::nodecint::arena;
+
+namespace {
+
+template <typename T>
+bool is_aligned(T const* p, size_t alignment = alignof(T)) {
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+struct alignas(64) cache_line {
+    uint8_t data[64];
+};
+
+// Appends its id to a shared log when destructed.
+struct tracked {
+    tracked(std::vector<int>& log, int id)
+        : log(log), id(id)
+    {}
+
+    ~tracked() {
+        log.push_back(id);
+    }
+
+    std::vector<int>& log;
+    int id;
+};
+
+} // namespace
+
+TEST_CASE("arena aligns every object") {
+    arena a(1024);
+
+    for (int i = 0; i < 200; ++i) {
+        // Odd sized allocations in between, to misalign the next offset.
+        CHECK(a.make<char>('x') != nullptr);
+        CHECK(is_aligned(a.make<uint16_t>(1)));
+        CHECK(is_aligned(a.make<uint32_t>(2)));
+        CHECK(is_aligned(a.make<double>(3.0)));
+        CHECK(is_aligned(a.make<long double>(4.0)));
+        CHECK(is_aligned(a.copy("abc")));
+        CHECK(is_aligned(a.make<cache_line>(), 64));
+    }
+}
+
+TEST_CASE("arena grows past a block") {
+    arena a(1024);
+
+    std::vector<uint64_t*> values;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        values.push_back(a.make<uint64_t>(i));
+    }
+
+    CHECK(a.bytes_reserved() > 1024);
+    CHECK(a.bytes_used() >= 1000 * sizeof(uint64_t));
+    CHECK(a.object_count() == 1000);
+
+    // Earlier blocks are not moved when a new one is added.
+    for (uint64_t i = 0; i < values.size(); ++i) {
+        CHECK(*values[i] == i);
+    }
+
+    SUBCASE("an object larger than the block size gets its own block") {
+        auto* big = a.make<std::array<char, 5000>>();
+        std::memset(big->data(), 7, big->size());
+        CHECK(is_aligned(big));
+        CHECK(a.bytes_reserved() >= 1024 + 5000);
+    }
+
+    SUBCASE("reset keeps the blocks") {
+        auto const reserved = a.bytes_reserved();
+        a.reset();
+        CHECK(a.object_count() == 0);
+        CHECK(a.bytes_used() == 0);
+
+        for (uint64_t i = 0; i < 1000; ++i) {
+            a.make<uint64_t>(i);
+        }
+        CHECK(a.bytes_reserved() == reserved);
+    }
+}
+
+TEST_CASE("arena copies strings") {
+    arena a(1024);
+    std::string const long_string(3000, 'z');
+
+    auto const* hello = a.copy("hello");
+    auto const* copy = a.copy(long_string);
+    auto const* empty = a.copy("");
+
+    CHECK(std::string(hello) == "hello");
+    CHECK(std::string(copy) == long_string);
+    CHECK(std::string(empty).empty());
+}
+
+TEST_CASE("arena destructs in reverse order") {
+    std::vector<int> log;
+
+    SUBCASE("on reset") {
+        arena a(1024);
+        for (int i = 0; i < 100; ++i) {
+            a.make<tracked>(log, i);
+            a.make<int>(i);         // trivially destructible, not tracked
+        }
+        CHECK(a.object_count() == 200);
+
+        a.reset();
+        REQUIRE(log.size() == 100);
+        for (int i = 0; i < 100; ++i) {
+            CHECK(log[i] == 99 - i);
+        }
+        CHECK(a.object_count() == 0);
+    }
+
+    SUBCASE("on destruction") {
+        {
+            arena a(1024);
+            a.make<tracked>(log, 1);
+            a.make<std::vector<int>>(1000, 5);
+            a.make<tracked>(log, 2);
+            a.make<tracked>(log, 3);
+        }
+        CHECK(log == std::vector<int>{3, 2, 1});
+    }
+}
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <bitprim/nodecint/chain/block_indexes.h>
+#include <bitprim/nodecint/chain/hash_list.h>
+#include <bitprim/nodecint/chain/point.h>
+#include <bitprim/nodecint/chain/point_list.h>
+
+namespace {
+
+std::vector<uint8_t> make_data(size_t n) {
+    std::vector<uint8_t> res(n);
+    for (size_t i = 0; i < n; ++i) {
+        res[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("hash list buffer round trip") {
+    size_t const count = 10;
+    auto const buffer = make_data(count * BITCOIN_HASH_SIZE);
+
+    auto list = chain_hash_list_construct_from_buffer(buffer.data(), count);
+    REQUIRE(chain_hash_list_count(list) == count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto const hash = chain_hash_list_nth(list, i);
+        CHECK(std::equal(hash.hash, hash.hash + BITCOIN_HASH_SIZE, buffer.begin() + i * BITCOIN_HASH_SIZE));
+    }
+
+    SUBCASE("whole list") {
+        std::vector<uint8_t> out(count * BITCOIN_HASH_SIZE);
+        CHECK(chain_hash_list_copy_to(list, out.data(), count) == count);
+        CHECK(out == buffer);
+    }
+
+    SUBCASE("capacity above the count") {
+        std::vector<uint8_t> out((count + 5) * BITCOIN_HASH_SIZE, 0xee);
+        CHECK(chain_hash_list_copy_to(list, out.data(), count + 5) == count);
+        CHECK(std::equal(buffer.begin(), buffer.end(), out.begin()));
+        CHECK(out[count * BITCOIN_HASH_SIZE] == 0xee);
+    }
+
+    SUBCASE("capacity below the count") {
+        // Nothing is written past the capacity.
+        std::vector<uint8_t> out(count * BITCOIN_HASH_SIZE, 0xee);
+        CHECK(chain_hash_list_copy_to(list, out.data(), 3) == 3);
+        CHECK(std::equal(out.begin(), out.begin() + 3 * BITCOIN_HASH_SIZE, buffer.begin()));
+        CHECK(out[3 * BITCOIN_HASH_SIZE] == 0xee);
+        CHECK(chain_hash_list_copy_to(list, out.data(), 0) == 0);
+    }
+
+    chain_hash_list_destruct(list);
+}
+
+TEST_CASE("hash list buffer empty") {
+    auto list = chain_hash_list_construct_from_buffer(nullptr, 0);
+    CHECK(chain_hash_list_count(list) == 0);
+    CHECK(chain_hash_list_copy_to(list, nullptr, 0) == 0);
+    chain_hash_list_destruct(list);
+}
+
+TEST_CASE("point list buffer round trip") {
+    size_t const count = 7;
+    auto buffer = make_data(count * BITCOIN_POINT_SIZE);
+
+    auto list = point_list_construct_from_buffer(buffer.data(), count);
+    REQUIRE(point_list_count(list) == count);
+
+    // The index is little endian after the hash.
+    for (size_t i = 0; i < count; ++i) {
+        auto const* expected = buffer.data() + i * BITCOIN_POINT_SIZE;
+        auto const point = point_list_nth(list, i);
+
+        auto const hash = chain_point_get_hash(point);
+        CHECK(std::equal(hash.hash, hash.hash + BITCOIN_HASH_SIZE, expected));
+
+        auto const* index = expected + BITCOIN_HASH_SIZE;
+        CHECK(chain_point_get_index(point) == (uint32_t(index[0]) | (uint32_t(index[1]) << 8) | (uint32_t(index[2]) << 16) | (uint32_t(index[3]) << 24)));
+    }
+
+    SUBCASE("whole list") {
+        std::vector<uint8_t> out(count * BITCOIN_POINT_SIZE);
+        CHECK(point_list_copy_to(list, out.data(), count) == count);
+        CHECK(out == buffer);
+    }
+
+    SUBCASE("capacity below the count") {
+        std::vector<uint8_t> out(count * BITCOIN_POINT_SIZE, 0xee);
+        CHECK(point_list_copy_to(list, out.data(), 2) == 2);
+        CHECK(std::equal(out.begin(), out.begin() + 2 * BITCOIN_POINT_SIZE, buffer.begin()));
+        CHECK(out[2 * BITCOIN_POINT_SIZE] == 0xee);
+    }
+
+    point_list_destruct(list);
+}
+
+TEST_CASE("block indexes buffer round trip") {
+    std::vector<uint64_t> const buffer {0, 1, 1000, 650000, UINT64_MAX};
+    auto const count = buffer.size();
+
+    auto list = chain_block_indexes_construct_from_buffer(buffer.data(), count);
+    REQUIRE(chain_block_indexes_count(list) == count);
+    for (size_t i = 0; i < count; ++i) {
+        CHECK(chain_block_indexes_nth(list, i) == buffer[i]);
+    }
+
+    SUBCASE("whole list") {
+        std::vector<uint64_t> out(count);
+        CHECK(chain_block_indexes_copy_to(list, out.data(), count) == count);
+        CHECK(out == buffer);
+    }
+
+    SUBCASE("capacity below the count") {
+        std::vector<uint64_t> out(count, 42);
+        CHECK(chain_block_indexes_copy_to(list, out.data(), 2) == 2);
+        CHECK(out == std::vector<uint64_t>{0, 1, 42, 42, 42});
+    }
+
+    chain_block_indexes_destruct(list);
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bitprim/nodecint/hex.hpp>
+
+namespace {
+
+struct codec {
+    char const* name;
+    bitprim::hex::decode_function decode;
+    bitprim::hex::encode_function encode;
+};
+
+// The vectorized codecs are skipped on CPUs without them.
+std::vector<codec> available_codecs() {
+    std::vector<codec> res;
+    res.push_back({"scalar", bitprim::hex::decode_scalar, bitprim::hex::encode_scalar});
+
+    if (bitprim::hex::decode_ssse3() != nullptr) {
+        res.push_back({"ssse3", bitprim::hex::decode_ssse3(), bitprim::hex::encode_ssse3()});
+    }
+
+    if (bitprim::hex::decode_avx2() != nullptr) {
+        res.push_back({"avx2", bitprim::hex::decode_avx2(), bitprim::hex::encode_avx2()});
+    }
+
+    return res;
+}
+
+std::vector<uint8_t> make_data(size_t n) {
+    std::vector<uint8_t> res(n);
+    for (size_t i = 0; i < n; ++i) {
+        res[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("hex codecs encode known bytes") {
+    std::vector<uint8_t> const data = {0x00, 0x01, 0x7f, 0x80, 0xab, 0xcd, 0xef, 0xff};
+
+    for (auto const& x : available_codecs()) {
+        CAPTURE(x.name);
+        std::string hex(2 * data.size(), '\0');
+        x.encode(data.data(), data.size(), &hex[0]);
+        CHECK(hex == "00017f80abcdefff");
+    }
+}
+
+TEST_CASE("hex codecs round trip") {
+    // Sizes around the 16 and 32 bytes blocks of the vectorized codecs, to cover their scalar tails.
+    for (auto const& x : available_codecs()) {
+        for (size_t n = 0; n <= 100; ++n) {
+            CAPTURE(x.name);
+            CAPTURE(n);
+
+            auto const data = make_data(n);
+            std::string hex(2 * n, '\0');
+            x.encode(data.data(), n, &hex[0]);
+
+            std::string expected(2 * n, '\0');
+            bitprim::hex::encode_scalar(data.data(), n, &expected[0]);
+            CHECK(hex == expected);
+
+            std::vector<uint8_t> decoded(n);
+            REQUIRE(x.decode(hex.data(), n, decoded.data()));
+            CHECK(decoded == data);
+        }
+    }
+}
+
+TEST_CASE("hex codecs decode upper case digits") {
+    std::string const hex = "ABCDEF0123456789abcdef0123456789ABCDEF0123456789abcdef0123456789";
+    auto const n = hex.size() / 2;
+
+    std::vector<uint8_t> expected(n);
+    REQUIRE(bitprim::hex::decode_scalar(hex.data(), n, expected.data()));
+    CHECK(expected[0] == 0xab);
+    CHECK(expected[1] == 0xcd);
+
+    for (auto const& x : available_codecs()) {
+        CAPTURE(x.name);
+        std::vector<uint8_t> decoded(n);
+        REQUIRE(x.decode(hex.data(), n, decoded.data()));
+        CHECK(decoded == expected);
+    }
+}
+
+TEST_CASE("hex codecs reject invalid characters") {
+    // Just outside each range of valid digits.
+    char const invalid[] = {'/', ':', '@', 'G', '`', 'g', ' ', '\0', '\x80', '\xff'};
+
+    for (auto const& x : available_codecs()) {
+        for (size_t n : {1, 15, 16, 17, 31, 32, 33, 64, 100}) {
+            auto const data = make_data(n);
+            std::string valid(2 * n, '\0');
+            bitprim::hex::encode_scalar(data.data(), n, &valid[0]);
+
+            // Every position, so that the vector blocks and the tails are all covered.
+            for (size_t position = 0; position < 2 * n; ++position) {
+                for (auto c : invalid) {
+                    CAPTURE(x.name);
+                    CAPTURE(n);
+                    CAPTURE(position);
+
+                    auto hex = valid;
+                    hex[position] = c;
+
+                    std::vector<uint8_t> decoded(n);
+                    CHECK_FALSE(x.decode(hex.data(), n, decoded.data()));
+                }
+            }
+        }
+    }
+}
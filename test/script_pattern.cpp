@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bitprim/nodecint/script_pattern.hpp>
+#include <bitprim/nodecint/chain/block.h>
+#include <bitprim/nodecint/chain/header.h>
+#include <bitprim/nodecint/chain/transaction.h>
+#include <bitprim/nodecint/chain/transaction_list.h>
+
+namespace {
+
+using script = std::vector<uint8_t>;
+using short_hash = std::vector<uint8_t>;
+
+constexpr uint8_t op_0 = 0x00;
+constexpr uint8_t op_1 = 0x51;
+constexpr uint8_t op_16 = 0x60;
+constexpr uint8_t op_return = 0x6a;
+constexpr uint8_t op_dup = 0x76;
+constexpr uint8_t op_equal = 0x87;
+constexpr uint8_t op_equalverify = 0x88;
+constexpr uint8_t op_hash160 = 0xa9;
+constexpr uint8_t op_checksig = 0xac;
+constexpr uint8_t op_checkmultisig = 0xae;
+
+std::vector<uint8_t> from_hex(std::string const& hex) {
+    std::vector<uint8_t> res;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        res.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+    }
+    return res;
+}
+
+std::vector<uint8_t> filled(size_t n, uint8_t value) {
+    return std::vector<uint8_t>(n, value);
+}
+
+script& operator<<(script& s, uint8_t op) {
+    s.push_back(op);
+    return s;
+}
+
+script& operator<<(script& s, std::vector<uint8_t> const& push) {
+    s.push_back(static_cast<uint8_t>(push.size()));
+    s.insert(s.end(), push.begin(), push.end());
+    return s;
+}
+
+// The hash is filled with a marker to tell whether it was written.
+script_pattern_t classify(script const& s, short_hash& out_hash) {
+    out_hash.assign(BITCOIN_SHORT_HASH_SIZE, 0xee);
+    return bitprim::nodecint::classify_output_script(s.data(), s.size(), out_hash.data());
+}
+
+script_pattern_t classify(script const& s) {
+    short_hash unused;
+    return classify(s, unused);
+}
+
+script pay_multisig(size_t m, size_t n, size_t key_size = 33) {
+    script res;
+    res << uint8_t(op_1 + m - 1);
+    for (size_t i = 0; i < n; ++i) {
+        res << filled(key_size, uint8_t(2 + i));
+    }
+    res << uint8_t(op_1 + n - 1) << op_checkmultisig;
+    return res;
+}
+
+// The coinbase of the genesis block, a single pay to public key output (uncompressed key).
+std::string const genesis_coinbase =
+    "01000000010000000000000000000000000000000000000000000000000000000000000000ffffffff4d04ffff001d0104455468652054"
+    "696d65732030332f4a616e2f32303039204368616e63656c6c6f72206f6e206272696e6b206f66207365636f6e64206261696c6f7574"
+    "20666f722062616e6b73ffffffff0100f2052a01000000434104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea"
+    "1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac00000000";
+
+std::string const genesis_key =
+    "04678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba"
+    "0b8d578a4c702b6bf11d5f";
+
+std::string const genesis_key_hash = "62e907b15cbf27d5425399ebf6f0fb50ebb88f18";
+
+} // namespace
+
+TEST_CASE("classify pay to key hash") {
+    auto const hash = filled(20, 0x11);
+    script s;
+    s << op_dup << op_hash160 << hash << op_equalverify << op_checksig;
+
+    short_hash out;
+    CHECK(classify(s, out) == script_pattern_pay_key_hash);
+    CHECK(out == hash);
+}
+
+TEST_CASE("classify pay to script hash") {
+    auto const hash = filled(20, 0x22);
+    script s;
+    s << op_hash160 << hash << op_equal;
+
+    short_hash out;
+    CHECK(classify(s, out) == script_pattern_pay_script_hash);
+    CHECK(out == hash);
+}
+
+TEST_CASE("classify pay to public key") {
+    SUBCASE("uncompressed key") {
+        script s;
+        s << from_hex(genesis_key) << op_checksig;
+
+        short_hash out;
+        CHECK(classify(s, out) == script_pattern_pay_public_key);
+        CHECK(out == from_hex(genesis_key_hash));
+    }
+
+    SUBCASE("compressed key") {
+        // The key of the private key 1.
+        script s;
+        s << from_hex("0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798") << op_checksig;
+
+        short_hash out;
+        CHECK(classify(s, out) == script_pattern_pay_public_key);
+        CHECK(out == from_hex("751e76e8199196d454941c45d1b3a323f1433bd6"));
+    }
+}
+
+TEST_CASE("classify pay to multisig") {
+    for (size_t n = 1; n <= 16; ++n) {
+        for (size_t m = 1; m <= n; ++m) {
+            CAPTURE(m);
+            CAPTURE(n);
+
+            short_hash out;
+            CHECK(classify(pay_multisig(m, n), out) == script_pattern_pay_multisig);
+            CHECK(out == filled(20, 0xee));
+        }
+    }
+
+    // Compressed and uncompressed keys can be mixed.
+    script mixed;
+    mixed << op_1 << filled(33, 2) << filled(65, 4) << uint8_t(op_1 + 1) << op_checkmultisig;
+    CHECK(classify(mixed) == script_pattern_pay_multisig);
+}
+
+TEST_CASE("classify null data") {
+    short_hash out;
+    CHECK(classify(script{op_return}, out) == script_pattern_null_data);
+    CHECK(out == filled(20, 0xee));
+
+    script s;
+    s << op_return << filled(40, 0x33);
+    CHECK(classify(s) == script_pattern_null_data);
+}
+
+TEST_CASE("classify malformed scripts") {
+    auto const hash = filled(20, 0x11);
+
+    CHECK(classify(script{}) == script_pattern_non_standard);
+
+    SUBCASE("pay to key hash") {
+        script short_push;
+        short_push << op_dup << op_hash160 << filled(19, 0x11) << op_equalverify << op_checksig;
+        CHECK(classify(short_push) == script_pattern_non_standard);
+
+        script long_push;
+        long_push << op_dup << op_hash160 << filled(21, 0x11) << op_equalverify << op_checksig;
+        CHECK(classify(long_push) == script_pattern_non_standard);
+
+        script trailing;
+        trailing << op_dup << op_hash160 << hash << op_equalverify << op_checksig << op_0;
+        CHECK(classify(trailing) == script_pattern_non_standard);
+
+        script wrong_op;
+        wrong_op << op_dup << op_hash160 << hash << op_equal << op_checksig;
+        CHECK(classify(wrong_op) == script_pattern_non_standard);
+    }
+
+    SUBCASE("pay to script hash") {
+        script truncated;
+        truncated << op_hash160 << hash;
+        CHECK(classify(truncated) == script_pattern_non_standard);
+
+        script short_push;
+        short_push << op_hash160 << filled(19, 0x22) << op_equal;
+        CHECK(classify(short_push) == script_pattern_non_standard);
+    }
+
+    SUBCASE("pay to public key") {
+        // Only 33 and 65 bytes keys.
+        for (size_t size : {0, 1, 32, 34, 64, 66}) {
+            CAPTURE(size);
+            script s;
+            s << filled(size, 2) << op_checksig;
+            CHECK(classify(s) == script_pattern_non_standard);
+        }
+
+        // The push length goes past the end.
+        script truncated{33, 2, 2, op_checksig};
+        CHECK(classify(truncated) == script_pattern_non_standard);
+    }
+
+    SUBCASE("pay to multisig") {
+        CHECK(classify(script{op_1, op_1, op_checkmultisig}) == script_pattern_non_standard);       // no keys
+        CHECK(classify(pay_multisig(3, 2)) == script_pattern_non_standard);                           // m > n
+        CHECK(classify(pay_multisig(1, 2, 34)) == script_pattern_non_standard);                       // key size
+
+        auto too_few = pay_multisig(1, 3);
+        too_few[too_few.size() - 2] = op_1 + 3;                                                       // n above the key count
+        CHECK(classify(too_few) == script_pattern_non_standard);
+
+        auto seventeen = pay_multisig(1, 16);
+        seventeen[seventeen.size() - 2] = op_16 + 1;
+        CHECK(classify(seventeen) == script_pattern_non_standard);
+
+        auto zero = pay_multisig(1, 1);
+        zero[0] = op_0;
+        CHECK(classify(zero) == script_pattern_non_standard);
+
+        // The last key push goes past n.
+        auto truncated = pay_multisig(1, 2);
+        truncated.erase(truncated.end() - 4);
+        CHECK(classify(truncated) == script_pattern_non_standard);
+    }
+}
+
+TEST_CASE("extract output destinations") {
+    auto const data = from_hex(genesis_coinbase);
+    auto header = chain_header_construct_default();
+    auto transactions = chain_transaction_list_construct_default();
+
+    // Twice the same coinbase, enough for the output positions.
+    for (size_t i = 0; i < 2; ++i) {
+        auto tx = chain_transaction_factory_from_data(1, data.data(), data.size());
+        REQUIRE(tx != nullptr);
+        chain_transaction_list_push_back(transactions, tx);
+        chain_transaction_destruct(tx);
+    }
+
+    auto block = chain_block_construct(header, transactions);
+
+    SUBCASE("capacity below the output count") {
+        std::vector<output_destination_t> out(1);
+        CHECK(chain_block_extract_output_destinations(block, out.data(), out.size()) == 1);
+    }
+
+    SUBCASE("one entry per output") {
+        std::vector<output_destination_t> out(2);
+        REQUIRE(chain_block_extract_output_destinations(block, out.data(), out.size()) == 0);
+
+        for (uint32_t i = 0; i < 2; ++i) {
+            CHECK(out[i].transaction_index == i);
+            CHECK(out[i].output_index == 0);
+            CHECK(out[i].pattern == script_pattern_pay_public_key);
+            CHECK(short_hash(out[i].hash, out[i].hash + BITCOIN_SHORT_HASH_SIZE) == from_hex(genesis_key_hash));
+        }
+    }
+
+    chain_block_destruct(block);
+    chain_transaction_list_destruct(transactions);
+    chain_header_destruct(header);
+}
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bitprim/nodecint/sha256.hpp>
+
+using bitprim::sha256::digest;
+
+namespace {
+
+struct backend {
+    char const* name;
+    bitprim::sha256::hash_function hash;
+};
+
+struct backend64 {
+    char const* name;
+    bitprim::sha256::hash64_function hash;
+};
+
+// The CPU extensions are skipped on CPUs without them.
+std::vector<backend> available_backends() {
+    std::vector<backend> res;
+    res.push_back({"scalar", bitprim::sha256::double_hash_scalar});
+    if (bitprim::sha256::double_hash_shani() != nullptr) {
+        res.push_back({"shani", bitprim::sha256::double_hash_shani()});
+    }
+    res.push_back({"dispatch", bitprim::sha256::double_hash});
+    return res;
+}
+
+std::vector<backend64> available_backends64() {
+    std::vector<backend64> res;
+    res.push_back({"scalar", bitprim::sha256::double_hash64_scalar});
+    if (bitprim::sha256::double_hash64_shani() != nullptr) {
+        res.push_back({"shani", bitprim::sha256::double_hash64_shani()});
+    }
+    if (bitprim::sha256::double_hash64_avx2() != nullptr) {
+        res.push_back({"avx2", bitprim::sha256::double_hash64_avx2()});
+    }
+    res.push_back({"dispatch", bitprim::sha256::double_hash64});
+    return res;
+}
+
+std::vector<uint8_t> from_hex(std::string const& hex) {
+    std::vector<uint8_t> res;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        res.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+    }
+    return res;
+}
+
+// Hashes are displayed with their bytes reversed.
+digest from_display(std::string const& hex) {
+    auto const bytes = from_hex(hex);
+    digest res;
+    std::reverse_copy(bytes.begin(), bytes.end(), res.begin());
+    return res;
+}
+
+digest from_bytes(std::string const& hex) {
+    auto const bytes = from_hex(hex);
+    digest res;
+    std::copy(bytes.begin(), bytes.end(), res.begin());
+    return res;
+}
+
+std::vector<uint8_t> make_data(size_t n) {
+    std::vector<uint8_t> res(n);
+    for (size_t i = 0; i < n; ++i) {
+        res[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("sha256 known double hashes") {
+    std::string const abc = "abc";
+    auto const genesis = from_hex(
+        "01000000" "0000000000000000000000000000000000000000000000000000000000000000"
+        "3ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4a"
+        "29ab5f49" "ffff001d" "1dac2b7c");
+
+    for (auto const& x : available_backends()) {
+        CAPTURE(x.name);
+        digest out;
+
+        x.hash(nullptr, 0, out.data());
+        CHECK(out == from_bytes("5df6e0e2761359d30a8275058e299fcc0381534545f55cf43e41983f5d4c9456"));
+
+        x.hash(reinterpret_cast<uint8_t const*>(abc.data()), abc.size(), out.data());
+        CHECK(out == from_bytes("4f8b42c22dd3729b519ba6f68d2da7cc5b2d606d05daed5ad5128cc03e6c6358"));
+
+        x.hash(genesis.data(), genesis.size(), out.data());
+        CHECK(out == from_display("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"));
+    }
+}
+
+TEST_CASE("sha256 backends match the scalar one") {
+    auto const data = make_data(5000);
+
+    SUBCASE("any length") {
+        // Around the block boundaries of the padding.
+        for (size_t n = 0; n < 300; ++n) {
+            digest expected;
+            bitprim::sha256::double_hash_scalar(data.data(), n, expected.data());
+
+            for (auto const& x : available_backends()) {
+                CAPTURE(x.name);
+                CAPTURE(n);
+                digest out;
+                x.hash(data.data(), n, out.data());
+                CHECK(out == expected);
+            }
+        }
+    }
+
+    SUBCASE("64 byte inputs") {
+        // Below, at and above the 8 lanes of AVX2.
+        for (size_t count = 0; count <= 40; ++count) {
+            std::vector<uint8_t> expected(32 * count);
+            for (size_t i = 0; i < count; ++i) {
+                bitprim::sha256::double_hash_scalar(data.data() + 64 * i, 64, expected.data() + 32 * i);
+            }
+
+            for (auto const& x : available_backends64()) {
+                CAPTURE(x.name);
+                CAPTURE(count);
+                std::vector<uint8_t> out(32 * count);
+                x.hash(data.data(), count, out.data());
+                CHECK(out == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("sha256 double_hash64 in place") {
+    auto const data = make_data(64 * 33);
+
+    for (auto const& x : available_backends64()) {
+        for (size_t count : {1, 2, 7, 8, 9, 16, 33}) {
+            CAPTURE(x.name);
+            CAPTURE(count);
+
+            std::vector<uint8_t> expected(32 * count);
+            bitprim::sha256::double_hash64_scalar(data.data(), count, expected.data());
+
+            std::vector<uint8_t> buffer(data.begin(), data.begin() + 64 * count);
+            x.hash(buffer.data(), count, buffer.data());
+            CHECK(std::vector<uint8_t>(buffer.begin(), buffer.begin() + 32 * count) == expected);
+        }
+    }
+}
+
+TEST_CASE("sha256 merkle root") {
+    // Block 100000.
+    std::vector<digest> const hashes {
+        from_display("8c14f0db3df150123e6f3dbbf30f8b955a8249b62ac1d1ff16284aefa3d06d87"),
+        from_display("fff2525b8931402dd09222c50775608f75787bd2b87e56995a7bdd30f79702c4"),
+        from_display("6359f0868171b1d194cbee1af2f16ea598ae8fad666d9b012c8ed2b79a236ec4"),
+        from_display("e9a66845e05d5abc0ad04ec80f774a7e585c6e8db975962d069a522137b80c1d"),
+    };
+
+    CHECK(bitprim::sha256::merkle_root(hashes) == from_display("f3e94742aca4b5ef85488dc37c06c3282295ffec960994b2c0d5ac2a25a95766"));
+
+    SUBCASE("odd count") {
+        // The third hash is paired with itself.
+        std::vector<digest> const three(hashes.begin(), hashes.begin() + 3);
+        CHECK(bitprim::sha256::merkle_root(three) == from_display("fa435470825de273081dcc706b25514c936fa6dc80ab965ce6970d68ddd0b553"));
+    }
+
+    SUBCASE("single and empty") {
+        CHECK(bitprim::sha256::merkle_root({hashes[0]}) == hashes[0]);
+        CHECK(bitprim::sha256::merkle_root({}) == digest{});
+    }
+
+    SUBCASE("parents in place") {
+        auto level = hashes;
+        bitprim::sha256::merkle_parents(level.data(), level.size(), level.data());
+        bitprim::sha256::merkle_parents(level.data(), 2, level.data());
+        CHECK(level[0] == bitprim::sha256::merkle_root(hashes));
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2017 Bitprim developers (see AUTHORS)
+ *
+ * This file is part of Bitprim.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <bitprim/nodecint/unspent_list.hpp>
+
+using libbitcoin::chain::history_compact;
+using libbitcoin::chain::point;
+
+namespace {
+
+point make_point(uint8_t seed, uint32_t index) {
+    libbitcoin::hash_digest hash;
+    for (size_t i = 0; i < hash.size(); ++i) {
+        hash[i] = static_cast<uint8_t>(seed + i);
+    }
+    return point(hash, index);
+}
+
+history_compact make_output(point const& output, uint32_t height, uint64_t value) {
+    history_compact row;
+    row.kind = libbitcoin::chain::point_kind::output;
+    row.point = output;
+    row.height = height;
+    row.value = value;
+    return row;
+}
+
+// The spend row points to the spending input, not to the output it spends.
+history_compact make_spend(point const& input, point const& spent, uint32_t height) {
+    history_compact row;
+    row.kind = libbitcoin::chain::point_kind::spend;
+    row.point = input;
+    row.height = height;
+    row.previous_checksum = spent.checksum();
+    return row;
+}
+
+} // namespace
+
+TEST_CASE("unspent list of an empty history") {
+    auto const res = bitprim::nodecint::make_unspent_list(history_compact::list{});
+    CHECK(res.outputs.empty());
+    CHECK(res.balance == 0);
+}
+
+TEST_CASE("unspent list pairs spends with their outputs") {
+    auto const a = make_point(1, 0);
+    auto const b = make_point(2, 1);
+    auto const c = make_point(3, 0);
+    auto const d = make_point(3, 1);    // same transaction as c, another output
+
+    history_compact::list const history {
+        make_spend(make_point(9, 0), c, 120),   // a spend may be listed before its output
+        make_output(a, 100, 5000),
+        make_output(b, 110, 7000),
+        make_output(c, 105, 11000),
+        make_output(d, 105, 13000),
+        make_spend(make_point(10, 2), a, 130),
+    };
+
+    auto const res = bitprim::nodecint::make_unspent_list(history);
+
+    REQUIRE(res.outputs.size() == 2);
+    CHECK(res.balance == 7000 + 13000);
+
+    // Ordered by height.
+    CHECK(res.outputs[0].height == 105);
+    CHECK(res.outputs[0].index == 1);
+    CHECK(res.outputs[0].value == 13000);
+    CHECK(std::equal(d.hash().begin(), d.hash().end(), res.outputs[0].hash.hash));
+
+    CHECK(res.outputs[1].height == 110);
+    CHECK(res.outputs[1].index == 1);
+    CHECK(res.outputs[1].value == 7000);
+    CHECK(std::equal(b.hash().begin(), b.hash().end(), res.outputs[1].hash.hash));
+}
+
+TEST_CASE("unspent list with every output spent") {
+    auto const a = make_point(1, 0);
+    auto const b = make_point(2, 0);
+
+    history_compact::list const history {
+        make_output(a, 1, 50),
+        make_output(b, 2, 60),
+        make_spend(make_point(3, 0), a, 3),
+        make_spend(make_point(3, 1), b, 3),
+    };
+
+    auto const res = bitprim::nodecint::make_unspent_list(history);
+    CHECK(res.outputs.empty());
+    CHECK(res.balance == 0);
+}
+
+TEST_CASE("unspent list ignores spends of outputs of other addresses") {
+    auto const a = make_point(1, 0);
+
+    history_compact::list const history {
+        make_output(a, 10, 42),
+        make_spend(make_point(5, 0), make_point(4, 0), 11),
+    };
+
+    auto const res = bitprim::nodecint::make_unspent_list(history);
+    REQUIRE(res.outputs.size() == 1);
+    CHECK(res.outputs[0].value == 42);
+    CHECK(res.balance == 42);
+}